@@ -1,10 +1,12 @@
 #ifndef ANIMATION_MANAGER_HPP
 #define ANIMATION_MANAGER_HPP
 
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
-#include <map>
 
 #include <SFML/Window/Event.hpp>
 
@@ -15,30 +17,110 @@ namespace rts
 {
     namespace AnimationManager
     {
+        // Refers to an animation created by the AnimationManager. A value
+        // initialized handle refers to no animation.
+        //
+        // The slot of an animation is reused once it is destroyed, the
+        // generation tells the animations that held the slot apart so that
+        // a handle of a destroyed animation never reaches a newer one.
+        struct AnimationHandle
+        {
+            std::uint32_t m_slot;
+            std::uint32_t m_generation;
+        };
+        
+        // A clip of animation frames, as read from the clip manifest
+        struct AnimationClip
+        {
+            std::string m_name;
+            
+            // The texture rect of each frame
+            std::vector<sf::IntRect> m_frames;
+            
+            // The time each frame ends at, from the start of the clip
+            std::vector<sf::Time> m_frameEnds;
+            
+            // Start over after the last frame, or stay on it?
+            bool m_loop;
+        };
+        
+        // Animations play clips loaded once from a manifest & referred to by
+        // their index. The animations of a clip form a group with one clock
+        // shared by all its members, so animations of the same clip always
+        // show the same frame & the cost of advancing them does not grow
+        // with their number.
+        //
+        // The frame of a group is not accumulated but computed from the time
+        // elapsed since the group started, so any number of frames can pass
+        // in one update & the animations can be seeked to any time.
+        //
+        // Lazy animations are not touched by the update at all, their owner
+        // asks for the current frame when drawing them.
+        //
+        // Animations given world bounds are registered in a grid of cells &
+        // only those in the cells under the view are updated, so the cost of
+        // an update follows what is on screen rather than the whole world.
+        //
+        // The animations to update are split into fixed chunks shown on the
+        // thread pool. Each animation writes only to its own sprite & slot of
+        // the packed arrays, so the result never depends on the threads.
         class AnimationManager
         {
             public:
                 
-                static bool exists( const std::string& id );
+                static bool exists( const AnimationHandle handle );
+                
+                // Load the clips of a manifest. Each clip starts with a line
+                //   clip <name> <loop|once>
+                // followed by one line for each of its frames
+                //   frame <left> <top> <width> <height> <duration in ms>
+                // Empty lines & those starting with a '#' are skipped.
+                static bool loadClips( const std::string& path );
+                
+                // The index of a clip by its name, -1 if there is none
+                static int getClip( const std::string& name );
+                
+                // The label only names the animation in the logs
+                static AnimationHandle createAnimation( sf::Sprite* entitySprite     ,
+                                                        const int clip               ,
+                                                        const std::string& label = "" );
+                
+                static AnimationHandle createAnimation( sf::VertexArray* vertexArray ,
+                                                        const int clip               ,
+                                                        const std::string& label = "" );
+                
+                // A lazy animation, without a sprite of its own
+                static AnimationHandle createAnimation( const int clip               ,
+                                                        const std::string& label = "" );
+                
+                // The frame an animation shows at the current time
+                static int getFrame( const AnimationHandle handle );
+                
+                // The texture rect of the frame an animation shows at the current time
+                static sf::IntRect getFrameRect( const AnimationHandle handle );
                 
-                static bool createAnimation( const std::string& id        ,
-                                             sf::Sprite* entitySprite     ,
-                                             const sf::Vector2i frameSize ,
-                                             const unsigned maxFrame      ,
-                                             const sf::Time frameDuration );
+                // The time of the animation clock, advanced by each update
+                static sf::Time getTime();
                 
-                static bool createAnimation( const std::string& id        ,
-                                             sf::VertexArray* vertexArray ,
-                                             const sf::Vector2i frameSize ,
-                                             const unsigned maxFrame      ,
-                                             const sf::Time frameDuration );
+                // Move the animation clock to any time, e.g., for a replay
+                static void setTime( const sf::Time now );
                 
-                static void destroyAnimation( const std::string& ID );
+                static void destroyAnimation( const AnimationHandle handle );
                 
-                // Sync a group of animation components to start together
-                static void syncAnimations( const std::vector<std::string>& animations );
+                // Restart the groups of some animations from their first frame
+                static void syncAnimations( const std::vector<AnimationHandle>& animations );
                 
-                static void setVisibility( const std::string& id, bool visibility );
+                static void setVisibility( const AnimationHandle handle, bool visibility );
+                
+                // Register the rectangle of the world an animation is drawn in,
+                // it is then updated only while the rectangle is in view
+                static void setBounds( const AnimationHandle handle, const sf::FloatRect& bounds );
+                
+                // The rectangle of the world in view, set once per frame
+                static void setViewRect( const sf::FloatRect& viewRect );
+                
+                // Forget the view, updating the animations wherever they are
+                static void resetViewRect();
                 
                 ////////////
                 // Update //
@@ -50,7 +132,110 @@ namespace rts
                 
             private:
                 
-                static std::map<std::string, WorldEntities::EntityComponents::AnimationComponent::Ptr> m_animations;
+                static AnimationHandle addAnimation( const WorldEntities::EntityComponents::AnimationComponent& component,
+                                                     const int clip,
+                                                     const std::string& label,
+                                                     const bool lazy );
+                
+                // The frame of a group at the current time
+                static int groupFrame( const std::uint32_t group );
+                
+                // Bring the frames of the groups to the current time & show
+                // them on the eager animations in view
+                static void refreshFrames();
+                
+                // Show the frame of its group on an animation, if it does not
+                // already. Safe to call for different animations at once.
+                static void showFrame( const std::size_t index );
+                
+                // Add or remove the slot of an animation to the cells under its bounds
+                static void registerBounds( const std::uint32_t slot, const sf::FloatRect& bounds, const bool add );
+                
+                // Position of the animation of a handle in the packed
+                // arrays below, -1 if the animation does not exist
+                static int indexOf( const AnimationHandle handle );
+                
+            private:
+                
+                struct Slot
+                {
+                    // Position of the animation in the packed arrays
+                    std::uint32_t m_index;
+                    
+                    // Bumped every time the animation in the slot is destroyed
+                    std::uint32_t m_generation;
+                };
+                
+                static std::vector<Slot> m_slots;
+                
+                // Slots not holding an animation
+                static std::vector<std::uint32_t> m_freeSlots;
+                
+                // The live animations, packed at the front of one array per field
+                // so that updating them walks through contiguous memory. Destroying
+                // an animation moves the last one into its place.
+                
+                static std::vector<WorldEntities::EntityComponents::AnimationComponent> m_components;
+                
+                // The clip, and so the group, of each animation
+                static std::vector<std::uint32_t> m_groups;
+                
+                static std::vector<bool> m_visible;
+                
+                // Set for the animations whose owner reads their frame
+                static std::vector<bool> m_lazy;
+                
+                // The slot holding each animation
+                static std::vector<std::uint32_t> m_owners;
+                
+                static std::vector<std::string> m_labels;
+                
+                // The frame each animation was last shown at
+                static std::vector<int> m_shownFrames;
+                
+                // The bounds of each animation in the world, empty if it has none
+                static std::vector<sf::FloatRect> m_bounds;
+                
+                // The update each animation was last visited in, so that an
+                // animation spanning several cells is visited once
+                static std::vector<unsigned> m_visits;
+                
+                // The animations in view found by the last update
+                static std::vector<std::uint32_t> m_pending;
+                
+                // Number of animations shown by a thread in one go
+                static constexpr std::size_t UPDATE_GRAIN = 2048;
+                
+                static std::vector<AnimationClip> m_clips;
+                
+                // The groups, indexed by clip, one array per field
+                
+                // The time each group started at
+                static std::vector<sf::Time> m_groupStarts;
+                
+                // The frame of each group at the last update
+                static std::vector<int> m_groupFrames;
+                
+                // The animation clock
+                static sf::Time m_now;
+                
+                // Side of a cell of the grid, in pixels
+                static constexpr float CELL_SIZE = 512.f;
+                
+                // The slots of the animations with bounds, by the cells
+                // under them, keyed by cell row & column
+                static std::map<std::pair<int, int>, std::vector<std::uint32_t>> m_cells;
+                
+                // The slots of the eager animations without bounds
+                static std::vector<std::uint32_t> m_unbounded;
+                
+                static sf::FloatRect m_viewRect;
+                
+                // Set while a view rectangle is in use
+                static bool m_culling;
+                
+                // Number of updates so far
+                static unsigned m_updates;
         };
     }
 }
@@ -27,12 +27,17 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
+#include <atomic>
+#include <mutex>
+#include <set>
 #include <stack>
 
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Sprite.hpp>
-#include <SFML/Graphics/Text.hpp>
+#include <SFML/System/Clock.hpp>
 
+#include "ResourceManager/ResourceManager.hpp"
+#include "UI/Components/C_UICaption.hpp"
 #include "GameStates/GameState.hpp"
 
 namespace rts
@@ -109,6 +114,20 @@ namespace rts
              */
             std::shared_ptr<GameState> peekState();
             
+            /* Get the assets needed by a state.
+             * 
+             * The main menu's set is loaded before the game
+             * starts, the others are loaded in the background.
+             */
+            static const ResourceManager::AssetSet& getAssetSet( const State state );
+            
+            /* Check whether the assets of a state are loaded.
+             * 
+             * The first time they are, the set is finished on
+             * this thread, e.g., its terrain textures packed.
+             */
+            bool assetSetReady( const State state );
+            
         public:
             
             // Main game window
@@ -128,12 +147,37 @@ namespace rts
             /* Debug info */
             
             // Frame rate info
-            sf::Text m_fps;
+            CManager::UIComponent::CaptionText m_fps;
             
             // Is the window focused?
             bool m_active;
             
+            // The states whose assets are loaded & finished
+            std::set<State> m_readySets;
+            
         private:
+            
+            /* The loop of the simulation thread.
+             * 
+             * Updates the state on top of the stack at the fixed
+             * rate while it allows it, see GameState::concurrentUpdate().
+             */
+            void simulate();
+            
+        private:
+            
+            // Held while the state stack or the state on top of it is
+            // handled, i.e., by the simulation thread during an update
+            // & by the main thread during input handling
+            std::mutex m_stateMutex;
+            
+            // Cleared to stop the simulation thread
+            std::atomic<bool> m_simulating;
+            
+            // Time of the last update of the simulation thread, on the
+            // step clock, in microseconds
+            sf::Clock m_stepClock;
+            std::atomic<sf::Int64> m_lastStep;
     };
 }
 
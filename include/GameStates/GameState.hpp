@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "Game.hpp"
+#include "ResourceManager/ResourceManager.hpp"
 
 namespace rts
 {
@@ -36,10 +37,28 @@ namespace rts
         public:
             
             /* Default constructor */
-            GameState(){}
+            GameState() :
+             m_game( nullptr ),
+             m_assetSet( nullptr )
+            {}
             
-            /* Virtual destructor */
-            virtual ~GameState(){}
+            /* Virtual destructor, releases the pinned asset set */
+            virtual ~GameState()
+            {
+                if ( m_assetSet )
+                    ResourceManager::releaseAssetSet( *m_assetSet );
+            }
+            
+            /* Keep the textures of an asset set loaded for as
+               long as this state is alive. */
+            void pinAssetSet( const ResourceManager::AssetSet& assetSet )
+            {
+                if ( m_assetSet )
+                    ResourceManager::releaseAssetSet( *m_assetSet );
+                
+                ResourceManager::pinAssetSet( assetSet );
+                m_assetSet = &assetSet;
+            }
             
             /* All derived classes must define methods with
                the following signatures to handle input,
@@ -49,14 +68,28 @@ namespace rts
             
             virtual void update(const sf::Time dt) = 0;
             
-            virtual void draw(const sf::Time dt) = 0;
+            /* alpha tells how far past the last update the frame is
+               drawn, in updates, from 0 to 1, to blend the positions
+               of the last two updates by. */
+            virtual void draw(const float alpha) = 0;
             
             virtual void freeze( bool f ) = 0;
             
+            /* Whether update() may run on a thread of its own, see
+               Game::run(). Such a state only touches its simulation
+               in update() & hands what draw() needs over through
+               snapshots. */
+            virtual bool concurrentUpdate() const { return false; }
+            
         public:
             
             // Pointer to the Game object of which this state is a part of
             Game* m_game;
+            
+        private:
+            
+            // The asset set pinned by this state, if any
+            const ResourceManager::AssetSet* m_assetSet;
     };
 }
 
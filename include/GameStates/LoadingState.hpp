@@ -0,0 +1,69 @@
+/*
+ * ---------------------------
+ *  Module    : GameStates
+ *  Submodule : LoadingState
+ * ---------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 01-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  This module contains a class that defines the loading screen
+ *  shown while the assets of a state are streaming in.
+ * 
+ */
+
+#ifndef LOADING_STATE_HPP
+#define LOADING_STATE_HPP
+
+#include <SFML/Graphics/RectangleShape.hpp>
+
+#include "GameStates/GameState.hpp"
+#include "UI/Components/C_UICaption.hpp"
+
+namespace rts
+{
+    class LoadingState : public GameState
+    {
+        public:
+            
+            typedef std::shared_ptr<LoadingState> Ptr;
+            
+        public:
+            
+            /* The pointer to the Game object which created
+               this LoadingState instance must be passed
+               while creation, along with the state to
+               replace it with once its assets are loaded.
+            */
+            LoadingState(Game::Ptr game, const Game::State target);
+            
+            /* Destructor */
+            ~LoadingState();
+            
+            /* Handle user input */
+            void handleInput() override;
+            
+            /* Follow the loading, switching to the target state once done */
+            void update(const sf::Time dt) override;
+            
+            /* Render the progress bar */
+            void draw(const float alpha) override;
+            
+            void freeze(bool f) override;
+            
+        private:
+            
+            // The state waiting for its assets
+            Game::State m_target;
+            
+            sf::RectangleShape m_barFrame;
+            sf::RectangleShape m_bar;
+            
+            CManager::UIComponent::CaptionText m_caption;
+    };
+}
+
+#endif // LOADING_STATE_HPP
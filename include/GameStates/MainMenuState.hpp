@@ -46,7 +46,7 @@ namespace rts
             void update(const sf::Time dt) override;
             
             /* Render the objects constituting the main menu */
-            void draw(const sf::Time dt) override;
+            void draw(const float alpha) override;
             
             void freeze(bool f) override;
         
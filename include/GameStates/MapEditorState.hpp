@@ -44,10 +44,13 @@ namespace rts
             void update( const sf::Time dt ) override;
             
             /* Render the objects constituting the main menu */
-            void draw( const sf::Time dt ) override;
+            void draw( const float alpha ) override;
             
             void freeze(bool f) override;
             
+            /* Only the map is updated, the UI follows it in draw() */
+            bool concurrentUpdate() const override;
+            
         private:
             
             // Boundaries for the widgets
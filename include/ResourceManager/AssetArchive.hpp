@@ -0,0 +1,136 @@
+/*
+ * --------------------------------
+ *  Module    : ResourceManager
+ *  Submodule : AssetArchive
+ * --------------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 01-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  This module contains the format of the packed asset archive &
+ *  a reader that maps it into memory. The archive is generated at
+ *  build time by tools/PackAssets.cpp.
+ * 
+ */
+
+#ifndef ASSET_ARCHIVE_HPP
+#define ASSET_ARCHIVE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rts
+{
+    // Layout of an archive, all fields little endian:
+    //
+    //   AssetArchiveHeader
+    //   AssetArchiveEntry * m_entryCount, sorted by m_id
+    //   The bytes of the files, each at the offset of its entry
+    
+    constexpr char ASSET_ARCHIVE_MAGIC[4] = { 'R', 'P', 'A', 'K' };
+    constexpr std::uint32_t ASSET_ARCHIVE_VERSION = 1;
+    
+    struct AssetArchiveHeader
+    {
+        char m_magic[4];
+        std::uint32_t m_version;
+        std::uint32_t m_entryCount;
+        std::uint32_t m_reserved;
+    };
+    
+    // Format of a packed file, from its extension
+    enum class AssetFormat : std::uint32_t
+    {
+        OTHER,
+        PNG,
+        JPG,
+        FONT
+    };
+    
+    struct AssetArchiveEntry
+    {
+        // Hash of the path the file is loaded by, see AssetArchive::hashPath()
+        std::uint64_t m_id;
+        
+        // Position & length of the file in the archive, in bytes
+        std::uint64_t m_offset;
+        std::uint64_t m_size;
+        
+        AssetFormat m_format;
+        std::uint32_t m_reserved;
+    };
+    
+    static_assert( sizeof( AssetArchiveHeader ) == 16 && sizeof( AssetArchiveEntry ) == 32,
+                   "The archive structs must have no padding" );
+    
+    // A read only view of an archive, mapped into memory if the platform
+    // allows & read whole otherwise. The bytes of the files stay valid
+    // until the archive is closed, so they can be used without a copy.
+    //
+    // Once opened, an archive may be read from any number of threads.
+    class AssetArchive
+    {
+        public:
+            
+            // The ID of the file loaded by a path, e.g., PATH_TEXTURES + TEXTURE_MOUSE_POINTER
+            // (64 bit FNV-1a of the path)
+            static inline std::uint64_t hashPath( const std::string& path );
+            
+        public:
+            
+            AssetArchive();
+            
+            ~AssetArchive();
+            
+            AssetArchive( const AssetArchive& ) = delete;
+            AssetArchive& operator= ( const AssetArchive& ) = delete;
+            
+            bool open( const std::string& path );
+            
+            void close();
+            
+            bool isOpen() const;
+            
+            // The bytes of the file loaded by a path, false if the file is not in the archive
+            bool find( const std::string& path, const void*& data, std::size_t& size ) const;
+            
+        private:
+            
+            // Check the header & entries of the archive bytes
+            bool validate();
+            
+        private:
+            
+            // The bytes of the whole archive
+            const char* m_data;
+            std::size_t m_size;
+            
+            const AssetArchiveEntry* m_entries;
+            std::uint32_t m_entryCount;
+            
+            // Set when m_data is mapped rather than read into m_buffer
+            bool m_mapped;
+            
+            std::vector<char> m_buffer;
+    };
+    
+    inline std::uint64_t AssetArchive::hashPath( const std::string& path )
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        
+        for ( auto&& c : path )
+        {
+            hash ^= static_cast<unsigned char>( c );
+            hash *= 1099511628211ull;
+        }
+        
+        return hash;
+    }
+}
+
+#endif // ASSET_ARCHIVE_HPP
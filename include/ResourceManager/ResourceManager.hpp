@@ -17,18 +17,26 @@
 #ifndef RESOURCE_MANAGER_HPP
 #define RESOURCE_MANAGER_HPP
 
-#include <map>
+#include <atomic>
+#include <deque>
+#include <set>
+#include <vector>
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Font.hpp>
 
+#include "ResourceManager/AssetArchive.hpp"
+
 namespace rts
 {
-
+    
     // Texture IDs    
-    enum class TextureID
+    enum class TextureID : std::int16_t
     {
         INVALID = -1                        ,
         
@@ -156,7 +164,7 @@ namespace rts
         TERRAIN_TILE_SNOW_1_1101           ,
         TERRAIN_TILE_SNOW_1_1110           ,
         TERRAIN_TILE_SNOW_1_1111           ,
-
+        
         
         
 //         TERRAIN_TILE_DESERT_01,
@@ -194,7 +202,7 @@ namespace rts
         
         MAX_TEXTURES
     };
-
+    
     
     // Font IDs    
     enum class FontID
@@ -216,7 +224,7 @@ namespace rts
         MAX_FONTS
     };
     
-    enum class TerrainType
+    enum class TerrainType : std::uint8_t
     {
         WATER,
         GRASS,
@@ -224,355 +232,288 @@ namespace rts
         SNOW,
         NON_TERRAIN_TEXTURE
     };
-
     
-    // Convert a texture ID to a string
     
-    static inline const std::string textureIDToStr( TextureID texID )
+    // Names of the textures, indexed by TextureID
+    constexpr const char* TEXTURE_NAMES[] =
     {
-        static const std::string idMap[] =
-        {
-            //"INVALID"                             ,
-            "MOUSE_POINTER"                       ,
-            "DEFAULT_BACKGROUND"                  ,
-            "MAIN_MENU_BACKGROUND"                ,
-            "MAP_EDITOR_BACKGROUND"               ,
-            "UI_DEFAULT_BUTTON"                   ,
-            "UI_MENU_BUTTON"                      ,
-            "UI_DEFAULT_PICTURE"                  ,
-            "UI_DEFAULT_RADIOBUTTON_NORMAL"       ,
-            "UI_DEFAULT_RADIOBUTTON_SELECTED"     ,
-            "UI_DEFAULT_LISTITEM"                 ,
-            "UI_DEFAULT_COMBOBOX_SELECTED"        ,
-            "UI_DEFAULT_COMBOBOX_ARROW"           ,
-            "UI_TILEBOX"                          ,
-            "UI_SCROLL_AREA"                      ,
-            "UI_SCROLL_BAR"                       ,
-            "UI_SCROLL_ARROW_UP"                  ,
-            "UI_SCROLL_ARROW_DOWN"                ,
-            
-            "TERRAIN_TILE_WATER_01"               ,
-            
-            "TERRAIN_TILE_GRASS_0_0000"           ,
-            "TERRAIN_TILE_GRASS_0_0001"           ,
-            "TERRAIN_TILE_GRASS_0_0010"           ,
-            "TERRAIN_TILE_GRASS_0_0011"           ,
-            "TERRAIN_TILE_GRASS_0_0100"           ,
-            "TERRAIN_TILE_GRASS_0_0101"           ,
-            "TERRAIN_TILE_GRASS_0_0110"           ,
-            "TERRAIN_TILE_GRASS_0_0111"           ,
-            "TERRAIN_TILE_GRASS_0_1000"           ,
-            "TERRAIN_TILE_GRASS_0_1001"           ,
-            "TERRAIN_TILE_GRASS_0_1010"           ,
-            "TERRAIN_TILE_GRASS_0_1011"           ,
-            "TERRAIN_TILE_GRASS_0_1100"           ,
-            "TERRAIN_TILE_GRASS_0_1101"           ,
-            "TERRAIN_TILE_GRASS_0_1110"           ,
-            "TERRAIN_TILE_GRASS_0_1111"           ,
-            
-            "TERRAIN_TILE_GRASS_1_0000"           ,
-            "TERRAIN_TILE_GRASS_1_0001"           ,
-            "TERRAIN_TILE_GRASS_1_0010"           ,
-            "TERRAIN_TILE_GRASS_1_0011"           ,
-            "TERRAIN_TILE_GRASS_1_0100"           ,
-            "TERRAIN_TILE_GRASS_1_0101"           ,
-            "TERRAIN_TILE_GRASS_1_0110"           ,
-            "TERRAIN_TILE_GRASS_1_0111"           ,
-            "TERRAIN_TILE_GRASS_1_1000"           ,
-            "TERRAIN_TILE_GRASS_1_1001"           ,
-            "TERRAIN_TILE_GRASS_1_1010"           ,
-            "TERRAIN_TILE_GRASS_1_1011"           ,
-            "TERRAIN_TILE_GRASS_1_1100"           ,
-            "TERRAIN_TILE_GRASS_1_1101"           ,
-            "TERRAIN_TILE_GRASS_1_1110"           ,
-            "TERRAIN_TILE_GRASS_1_1111"           ,
-            
-            "TERRAIN_TILE_DESERT_0_0000"           ,
-            "TERRAIN_TILE_DESERT_0_0001"           ,
-            "TERRAIN_TILE_DESERT_0_0010"           ,
-            "TERRAIN_TILE_DESERT_0_0011"           ,
-            "TERRAIN_TILE_DESERT_0_0100"           ,
-            "TERRAIN_TILE_DESERT_0_0101"           ,
-            "TERRAIN_TILE_DESERT_0_0110"           ,
-            "TERRAIN_TILE_DESERT_0_0111"           ,
-            "TERRAIN_TILE_DESERT_0_1000"           ,
-            "TERRAIN_TILE_DESERT_0_1001"           ,
-            "TERRAIN_TILE_DESERT_0_1010"           ,
-            "TERRAIN_TILE_DESERT_0_1011"           ,
-            "TERRAIN_TILE_DESERT_0_1100"           ,
-            "TERRAIN_TILE_DESERT_0_1101"           ,
-            "TERRAIN_TILE_DESERT_0_1110"           ,
-            "TERRAIN_TILE_DESERT_0_1111"           ,
-            
-            "TERRAIN_TILE_DESERT_1_0000"           ,
-            "TERRAIN_TILE_DESERT_1_0001"           ,
-            "TERRAIN_TILE_DESERT_1_0010"           ,
-            "TERRAIN_TILE_DESERT_1_0011"           ,
-            "TERRAIN_TILE_DESERT_1_0100"           ,
-            "TERRAIN_TILE_DESERT_1_0101"           ,
-            "TERRAIN_TILE_DESERT_1_0110"           ,
-            "TERRAIN_TILE_DESERT_1_0111"           ,
-            "TERRAIN_TILE_DESERT_1_1000"           ,
-            "TERRAIN_TILE_DESERT_1_1001"           ,
-            "TERRAIN_TILE_DESERT_1_1010"           ,
-            "TERRAIN_TILE_DESERT_1_1011"           ,
-            "TERRAIN_TILE_DESERT_1_1100"           ,
-            "TERRAIN_TILE_DESERT_1_1101"           ,
-            "TERRAIN_TILE_DESERT_1_1110"           ,
-            "TERRAIN_TILE_DESERT_1_1111"           ,
-            
-            "TERRAIN_TILE_SNOW_0_0000"           ,
-            "TERRAIN_TILE_SNOW_0_0001"           ,
-            "TERRAIN_TILE_SNOW_0_0010"           ,
-            "TERRAIN_TILE_SNOW_0_0011"           ,
-            "TERRAIN_TILE_SNOW_0_0100"           ,
-            "TERRAIN_TILE_SNOW_0_0101"           ,
-            "TERRAIN_TILE_SNOW_0_0110"           ,
-            "TERRAIN_TILE_SNOW_0_0111"           ,
-            "TERRAIN_TILE_SNOW_0_1000"           ,
-            "TERRAIN_TILE_SNOW_0_1001"           ,
-            "TERRAIN_TILE_SNOW_0_1010"           ,
-            "TERRAIN_TILE_SNOW_0_1011"           ,
-            "TERRAIN_TILE_SNOW_0_1100"           ,
-            "TERRAIN_TILE_SNOW_0_1101"           ,
-            "TERRAIN_TILE_SNOW_0_1110"           ,
-            "TERRAIN_TILE_SNOW_0_1111"           ,
-            
-            "TERRAIN_TILE_SNOW_1_0000"           ,
-            "TERRAIN_TILE_SNOW_1_0001"           ,
-            "TERRAIN_TILE_SNOW_1_0010"           ,
-            "TERRAIN_TILE_SNOW_1_0011"           ,
-            "TERRAIN_TILE_SNOW_1_0100"           ,
-            "TERRAIN_TILE_SNOW_1_0101"           ,
-            "TERRAIN_TILE_SNOW_1_0110"           ,
-            "TERRAIN_TILE_SNOW_1_0111"           ,
-            "TERRAIN_TILE_SNOW_1_1000"           ,
-            "TERRAIN_TILE_SNOW_1_1001"           ,
-            "TERRAIN_TILE_SNOW_1_1010"           ,
-            "TERRAIN_TILE_SNOW_1_1011"           ,
-            "TERRAIN_TILE_SNOW_1_1100"           ,
-            "TERRAIN_TILE_SNOW_1_1101"           ,
-            "TERRAIN_TILE_SNOW_1_1110"           ,
-            "TERRAIN_TILE_SNOW_1_1111"           ,
-            
-
-//             "TERRAIN_TILE_DESERT_01"              ,
-//             
-//             "TERRAIN_TILE_WATER_01"               ,
-//             
-//             "TERRAIN_TILE_GRASS_01"               ,
-//             "TERRAIN_TILE_GRASS_DESERT_01"        ,
-//             "TERRAIN_TILE_GRASS_DESERT_02"        ,
-//             "TERRAIN_TILE_GRASS_DESERT_012"       ,
-//             "TERRAIN_TILE_GRASS_DESERT_013"       ,
-//             "TERRAIN_TILE_GRASS_DESERT_112"       ,
-//             "TERRAIN_TILE_GRASS_DESERT_113"       ,
-//             "TERRAIN_TILE_GRASS_DESERT_114"       ,
-//             "TERRAIN_TILE_GRASS_DESERT_01432"     ,
-//             "TERRAIN_TILE_GRASS_DESERT_11432"     ,
-//             "TERRAIN_TILE_GRASS_DESERT_132"       ,
-//             "TERRAIN_TILE_GRASS_DESERT_134"       ,
-//             "TERRAIN_TILE_GRASS_DESERT_03"        ,
-//             "TERRAIN_TILE_GRASS_DESERT_04"        ,
-//             
-//             "TERRAIN_TILE_BEACH_01"               ,
-//             "TERRAIN_TILE_BEACH_014"              ,
-//             "TERRAIN_TILE_BEACH_02"               ,
-//             "TERRAIN_TILE_BEACH_023"              ,
-//             "TERRAIN_TILE_BEACH_03"               ,
-//             "TERRAIN_TILE_BEACH_032"              ,
-//             "TERRAIN_TILE_BEACH_04"               ,
-//             
-//             "TERRAIN_TILE_BEACH_013"              ,
-//             "TERRAIN_TILE_BEACH_113"              ,
-//             "TERRAIN_TILE_BEACH_123"              ,
-//             "TERRAIN_TILE_BEACH_0013"             ,
-//             "TERRAIN_TILE_BEACH_1113"             
-        };
-
-        if ( texID >= TextureID::INVALID && texID < TextureID::MAX_TEXTURES )
-            return idMap[static_cast<int>( texID )];
+        //"INVALID"                             ,
+        "MOUSE_POINTER"                       ,
+        "DEFAULT_BACKGROUND"                  ,
+        "MAIN_MENU_BACKGROUND"                ,
+        "MAP_EDITOR_BACKGROUND"               ,
+        "UI_DEFAULT_BUTTON"                   ,
+        "UI_MENU_BUTTON"                      ,
+        "UI_DEFAULT_PICTURE"                  ,
+        "UI_DEFAULT_RADIOBUTTON_NORMAL"       ,
+        "UI_DEFAULT_RADIOBUTTON_SELECTED"     ,
+        "UI_DEFAULT_LISTITEM"                 ,
+        "UI_DEFAULT_COMBOBOX_SELECTED"        ,
+        "UI_DEFAULT_COMBOBOX_ARROW"           ,
+        "UI_TILEBOX"                          ,
+        "UI_SCROLL_AREA"                      ,
+        "UI_SCROLL_BAR"                       ,
+        "UI_SCROLL_ARROW_UP"                  ,
+        "UI_SCROLL_ARROW_DOWN"                ,
+        
+        "TERRAIN_TILE_WATER_01"               ,
+        
+        "TERRAIN_TILE_GRASS_0_0000"           ,
+        "TERRAIN_TILE_GRASS_0_0001"           ,
+        "TERRAIN_TILE_GRASS_0_0010"           ,
+        "TERRAIN_TILE_GRASS_0_0011"           ,
+        "TERRAIN_TILE_GRASS_0_0100"           ,
+        "TERRAIN_TILE_GRASS_0_0101"           ,
+        "TERRAIN_TILE_GRASS_0_0110"           ,
+        "TERRAIN_TILE_GRASS_0_0111"           ,
+        "TERRAIN_TILE_GRASS_0_1000"           ,
+        "TERRAIN_TILE_GRASS_0_1001"           ,
+        "TERRAIN_TILE_GRASS_0_1010"           ,
+        "TERRAIN_TILE_GRASS_0_1011"           ,
+        "TERRAIN_TILE_GRASS_0_1100"           ,
+        "TERRAIN_TILE_GRASS_0_1101"           ,
+        "TERRAIN_TILE_GRASS_0_1110"           ,
+        "TERRAIN_TILE_GRASS_0_1111"           ,
+        
+        "TERRAIN_TILE_GRASS_1_0000"           ,
+        "TERRAIN_TILE_GRASS_1_0001"           ,
+        "TERRAIN_TILE_GRASS_1_0010"           ,
+        "TERRAIN_TILE_GRASS_1_0011"           ,
+        "TERRAIN_TILE_GRASS_1_0100"           ,
+        "TERRAIN_TILE_GRASS_1_0101"           ,
+        "TERRAIN_TILE_GRASS_1_0110"           ,
+        "TERRAIN_TILE_GRASS_1_0111"           ,
+        "TERRAIN_TILE_GRASS_1_1000"           ,
+        "TERRAIN_TILE_GRASS_1_1001"           ,
+        "TERRAIN_TILE_GRASS_1_1010"           ,
+        "TERRAIN_TILE_GRASS_1_1011"           ,
+        "TERRAIN_TILE_GRASS_1_1100"           ,
+        "TERRAIN_TILE_GRASS_1_1101"           ,
+        "TERRAIN_TILE_GRASS_1_1110"           ,
+        "TERRAIN_TILE_GRASS_1_1111"           ,
+        
+        "TERRAIN_TILE_DESERT_0_0000"           ,
+        "TERRAIN_TILE_DESERT_0_0001"           ,
+        "TERRAIN_TILE_DESERT_0_0010"           ,
+        "TERRAIN_TILE_DESERT_0_0011"           ,
+        "TERRAIN_TILE_DESERT_0_0100"           ,
+        "TERRAIN_TILE_DESERT_0_0101"           ,
+        "TERRAIN_TILE_DESERT_0_0110"           ,
+        "TERRAIN_TILE_DESERT_0_0111"           ,
+        "TERRAIN_TILE_DESERT_0_1000"           ,
+        "TERRAIN_TILE_DESERT_0_1001"           ,
+        "TERRAIN_TILE_DESERT_0_1010"           ,
+        "TERRAIN_TILE_DESERT_0_1011"           ,
+        "TERRAIN_TILE_DESERT_0_1100"           ,
+        "TERRAIN_TILE_DESERT_0_1101"           ,
+        "TERRAIN_TILE_DESERT_0_1110"           ,
+        "TERRAIN_TILE_DESERT_0_1111"           ,
+        
+        "TERRAIN_TILE_DESERT_1_0000"           ,
+        "TERRAIN_TILE_DESERT_1_0001"           ,
+        "TERRAIN_TILE_DESERT_1_0010"           ,
+        "TERRAIN_TILE_DESERT_1_0011"           ,
+        "TERRAIN_TILE_DESERT_1_0100"           ,
+        "TERRAIN_TILE_DESERT_1_0101"           ,
+        "TERRAIN_TILE_DESERT_1_0110"           ,
+        "TERRAIN_TILE_DESERT_1_0111"           ,
+        "TERRAIN_TILE_DESERT_1_1000"           ,
+        "TERRAIN_TILE_DESERT_1_1001"           ,
+        "TERRAIN_TILE_DESERT_1_1010"           ,
+        "TERRAIN_TILE_DESERT_1_1011"           ,
+        "TERRAIN_TILE_DESERT_1_1100"           ,
+        "TERRAIN_TILE_DESERT_1_1101"           ,
+        "TERRAIN_TILE_DESERT_1_1110"           ,
+        "TERRAIN_TILE_DESERT_1_1111"           ,
+        
+        "TERRAIN_TILE_SNOW_0_0000"           ,
+        "TERRAIN_TILE_SNOW_0_0001"           ,
+        "TERRAIN_TILE_SNOW_0_0010"           ,
+        "TERRAIN_TILE_SNOW_0_0011"           ,
+        "TERRAIN_TILE_SNOW_0_0100"           ,
+        "TERRAIN_TILE_SNOW_0_0101"           ,
+        "TERRAIN_TILE_SNOW_0_0110"           ,
+        "TERRAIN_TILE_SNOW_0_0111"           ,
+        "TERRAIN_TILE_SNOW_0_1000"           ,
+        "TERRAIN_TILE_SNOW_0_1001"           ,
+        "TERRAIN_TILE_SNOW_0_1010"           ,
+        "TERRAIN_TILE_SNOW_0_1011"           ,
+        "TERRAIN_TILE_SNOW_0_1100"           ,
+        "TERRAIN_TILE_SNOW_0_1101"           ,
+        "TERRAIN_TILE_SNOW_0_1110"           ,
+        "TERRAIN_TILE_SNOW_0_1111"           ,
+        
+        "TERRAIN_TILE_SNOW_1_0000"           ,
+        "TERRAIN_TILE_SNOW_1_0001"           ,
+        "TERRAIN_TILE_SNOW_1_0010"           ,
+        "TERRAIN_TILE_SNOW_1_0011"           ,
+        "TERRAIN_TILE_SNOW_1_0100"           ,
+        "TERRAIN_TILE_SNOW_1_0101"           ,
+        "TERRAIN_TILE_SNOW_1_0110"           ,
+        "TERRAIN_TILE_SNOW_1_0111"           ,
+        "TERRAIN_TILE_SNOW_1_1000"           ,
+        "TERRAIN_TILE_SNOW_1_1001"           ,
+        "TERRAIN_TILE_SNOW_1_1010"           ,
+        "TERRAIN_TILE_SNOW_1_1011"           ,
+        "TERRAIN_TILE_SNOW_1_1100"           ,
+        "TERRAIN_TILE_SNOW_1_1101"           ,
+        "TERRAIN_TILE_SNOW_1_1110"           ,
+        "TERRAIN_TILE_SNOW_1_1111"           ,
+        
 
-        return idMap[0]; // i.e., INVALID_TEXTURE
+//         "TERRAIN_TILE_DESERT_01"              ,
+//         
+//         "TERRAIN_TILE_WATER_01"               ,
+//         
+//         "TERRAIN_TILE_GRASS_01"               ,
+//         "TERRAIN_TILE_GRASS_DESERT_01"        ,
+//         "TERRAIN_TILE_GRASS_DESERT_02"        ,
+//         "TERRAIN_TILE_GRASS_DESERT_012"       ,
+//         "TERRAIN_TILE_GRASS_DESERT_013"       ,
+//         "TERRAIN_TILE_GRASS_DESERT_112"       ,
+//         "TERRAIN_TILE_GRASS_DESERT_113"       ,
+//         "TERRAIN_TILE_GRASS_DESERT_114"       ,
+//         "TERRAIN_TILE_GRASS_DESERT_01432"     ,
+//         "TERRAIN_TILE_GRASS_DESERT_11432"     ,
+//         "TERRAIN_TILE_GRASS_DESERT_132"       ,
+//         "TERRAIN_TILE_GRASS_DESERT_134"       ,
+//         "TERRAIN_TILE_GRASS_DESERT_03"        ,
+//         "TERRAIN_TILE_GRASS_DESERT_04"        ,
+//         
+//         "TERRAIN_TILE_BEACH_01"               ,
+//         "TERRAIN_TILE_BEACH_014"              ,
+//         "TERRAIN_TILE_BEACH_02"               ,
+//         "TERRAIN_TILE_BEACH_023"              ,
+//         "TERRAIN_TILE_BEACH_03"               ,
+//         "TERRAIN_TILE_BEACH_032"              ,
+//         "TERRAIN_TILE_BEACH_04"               ,
+//         
+//         "TERRAIN_TILE_BEACH_013"              ,
+//         "TERRAIN_TILE_BEACH_113"              ,
+//         "TERRAIN_TILE_BEACH_123"              ,
+//         "TERRAIN_TILE_BEACH_0013"             ,
+//         "TERRAIN_TILE_BEACH_1113"
+    };
+    
+    static_assert( sizeof( TEXTURE_NAMES ) / sizeof( TEXTURE_NAMES[0] ) == static_cast<std::size_t>( TextureID::MAX_TEXTURES ),
+                   "TEXTURE_NAMES must name every TextureID, in order" );
+    
+    // Names of the fonts, indexed by FontID
+    constexpr const char* FONT_NAMES[] =
+    {
+        //"INVALID"                    ,
+        "DEFAULT"                         ,
+        "BASKERVILLE_OLD_FACE_REGULAR"    ,
+        "BEYOND_WONDERLAND"               ,
+        "BOOK_ANTIQUA_BOLD"               ,
+        "CLOISTER_BLACK_LIGHT"            ,
+        "CONSTANTIA_REGULAR"              ,
+        "DEJAVU_SERIF_BOOK"               ,
+        "GARAMOND_BOLD"                   ,
+        "MONACO"                          ,
+        "OLD_SERIF_GUT_REGULAR"           ,
+        "RINGBEARER_MEDIUM"               ,
+        "ROBOTO_BOLD"                     ,
+        "SOURCE_HAN_SANS_CN_NORMAL"
+    };
+    
+    static_assert( sizeof( FONT_NAMES ) / sizeof( FONT_NAMES[0] ) == static_cast<std::size_t>( FontID::MAX_FONTS ),
+                   "FONT_NAMES must name every FontID, in order" );
+    
+    // Does a texture ID refer to a texture?
+    constexpr bool isValidTexture( TextureID texID )
+    {
+        return texID > TextureID::INVALID && texID < TextureID::MAX_TEXTURES;
     }
     
+    // Does a font ID refer to a font?
+    constexpr bool isValidFont( FontID fontID )
+    {
+        return fontID > FontID::INVALID && fontID < FontID::MAX_FONTS;
+    }
+    
+    // Convert a texture ID to a string
+    constexpr const char* textureIDToStr( TextureID texID )
+    {
+        return isValidTexture( texID ) ? TEXTURE_NAMES[static_cast<int>( texID )] : "INVALID";
+    }
     
     // Convert a font ID to a string
-
-    static inline const std::string fontIDToStr( FontID fontID )
+    constexpr const char* fontIDToStr( FontID fontID )
     {
-        static const std::string idMap[] =
-        {
-            //"INVALID"                    ,
-            "DEFAULT"                         ,
-            "BASKERVILLE_OLD_FACE_REGULAR"    ,
-            "BEYOND_WONDERLAND"               ,
-            "BOOK_ANTIQUA_BOLD"               ,
-            "CLOISTER_BLACK_LIGHT"            ,
-            "CONSTANTIA_REGULAR"              ,
-            "DEJAVU_SERIF_BOOK"               ,
-            "GARAMOND_BOLD"                   ,
-            "MONACO"                          ,
-            "OLD_SERIF_GUT_REGULAR"           ,
-            "RINGBEARER_MEDIUM"               ,
-            "ROBOTO_BOLD"                     ,
-            "SOURCE_HAN_SANS_CN_NORMAL"       ,
-            "MAX_FONTS"
-        };
-
-        if ( fontID >= FontID::INVALID && fontID < FontID::MAX_FONTS )
-            return idMap[static_cast<int>( fontID )];
-
-        return idMap[0]; // i.e., INVALID
+        return isValidFont( fontID ) ? FONT_NAMES[static_cast<int>( fontID )] : "INVALID";
     }
     
-    // Determine whether a texture is animated or not
-    static inline bool isAnimatedTexture( TextureID texID )
+    // Properties of a texture looked up when painting tiles
+    struct TextureInfo
+    {
+        TerrainType m_terrain;
+        bool m_animated;
+    };
+    
+    struct TextureInfoTable
+    {
+        TextureInfo m_info[static_cast<int>( TextureID::MAX_TEXTURES )];
+    };
+    
+    // Build the properties of all the textures at compile time. The tile
+    // textures of a terrain are contiguous in TextureID, from the first
+    // straight overlay to the last diagonal one.
+    constexpr TextureInfoTable makeTextureInfoTable()
     {
-        static const std::map<TextureID, bool> animatedTextureMap =
+        TextureInfoTable table{};
+        
+        for ( int t = 0; t < static_cast<int>( TextureID::MAX_TEXTURES ); ++t )
         {
-            { TextureID::TERRAIN_TILE_WATER_01, true}
-        };
+            table.m_info[t].m_terrain = TerrainType::NON_TERRAIN_TEXTURE;
+            table.m_info[t].m_animated = false;
+        }
+        
+        table.m_info[static_cast<int>( TextureID::TERRAIN_TILE_WATER_01 )].m_terrain = TerrainType::WATER;
+        table.m_info[static_cast<int>( TextureID::TERRAIN_TILE_WATER_01 )].m_animated = true;
+        
+        for ( int t = static_cast<int>( TextureID::TERRAIN_TILE_GRASS_0_0000 ); t <= static_cast<int>( TextureID::TERRAIN_TILE_GRASS_1_1111 ); ++t )
+            table.m_info[t].m_terrain = TerrainType::GRASS;
         
-        return animatedTextureMap.find( texID ) != animatedTextureMap.end();
+        for ( int t = static_cast<int>( TextureID::TERRAIN_TILE_DESERT_0_0000 ); t <= static_cast<int>( TextureID::TERRAIN_TILE_DESERT_1_1111 ); ++t )
+            table.m_info[t].m_terrain = TerrainType::DESERT;
+        
+        for ( int t = static_cast<int>( TextureID::TERRAIN_TILE_SNOW_0_0000 ); t <= static_cast<int>( TextureID::TERRAIN_TILE_SNOW_1_1111 ); ++t )
+            table.m_info[t].m_terrain = TerrainType::SNOW;
+        
+        return table;
+    }
+    
+    constexpr TextureInfoTable TEXTURE_INFO = makeTextureInfoTable();
+    
+    // Determine whether a texture is animated or not
+    constexpr bool isAnimatedTexture( TextureID texID )
+    {
+        return isValidTexture( texID ) && TEXTURE_INFO.m_info[static_cast<int>( texID )].m_animated;
     }
     
     // Determine the type of a terrain texture
-    static inline TerrainType getTerrainType( TextureID texID )
+    constexpr TerrainType getTerrainType( TextureID texID )
     {
-        static const std::map<TextureID, TerrainType> terrainTypeMap =
-        {
-            { TextureID::TERRAIN_TILE_WATER_01, TerrainType::WATER } ,
-            
-            { TextureID::TERRAIN_TILE_GRASS_0_0000, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_0001, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_0010, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_0011, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_0100, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_0101, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_0110, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_0111, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_1000, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_1001, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_1010, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_1011, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_1100, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_1101, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_1110, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_0_1111, TerrainType::GRASS },
-            
-            { TextureID::TERRAIN_TILE_GRASS_1_0000, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_0001, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_0010, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_0011, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_0100, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_0101, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_0110, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_0111, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_1000, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_1001, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_1010, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_1011, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_1100, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_1101, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_1110, TerrainType::GRASS },
-            { TextureID::TERRAIN_TILE_GRASS_1_1111, TerrainType::GRASS },
-            
-            { TextureID::TERRAIN_TILE_GRASS_0_0000, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_0001, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_0010, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_0011, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_0100, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_0101, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_0110, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_0111, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_1000, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_1001, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_1010, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_1011, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_1100, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_1101, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_1110, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_GRASS_0_1111, TerrainType::DESERT },
-            
-            { TextureID::TERRAIN_TILE_DESERT_0_0000, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_0001, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_0010, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_0011, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_0100, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_0101, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_0110, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_0111, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_1000, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_1001, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_1010, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_1011, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_1100, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_1101, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_1110, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_0_1111, TerrainType::DESERT },
-            
-            { TextureID::TERRAIN_TILE_DESERT_1_0000, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_0001, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_0010, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_0011, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_0100, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_0101, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_0110, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_0111, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_1000, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_1001, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_1010, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_1011, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_1100, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_1101, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_1110, TerrainType::DESERT },
-            { TextureID::TERRAIN_TILE_DESERT_1_1111, TerrainType::DESERT },
-            
-            { TextureID::TERRAIN_TILE_SNOW_0_0000, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_0001, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_0010, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_0011, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_0100, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_0101, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_0110, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_0111, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_1000, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_1001, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_1010, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_1011, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_1100, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_1101, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_1110, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_0_1111, TerrainType::SNOW },
-            
-            { TextureID::TERRAIN_TILE_SNOW_1_0000, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_0001, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_0010, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_0011, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_0100, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_0101, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_0110, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_0111, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_1000, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_1001, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_1010, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_1011, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_1100, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_1101, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_1110, TerrainType::SNOW },
-            { TextureID::TERRAIN_TILE_SNOW_1_1111, TerrainType::SNOW }
-        };
-        
-        auto it = terrainTypeMap.find( texID );
-        if ( it != terrainTypeMap.end() )
-        {
-            return it->second;
-        }
+        return isValidTexture( texID ) ? TEXTURE_INFO.m_info[static_cast<int>( texID )].m_terrain : TerrainType::NON_TERRAIN_TEXTURE;
+    }
+    
+    // What the texture memory is spent on
+    enum class TextureCategory
+    {
+        INTERFACE       ,
+        TERRAIN         ,
+        TERRAIN_ATLAS   ,
         
-        return TerrainType::NON_TERRAIN_TEXTURE;
+        MAX_CATEGORIES
+    };
+    
+    // Determine the category of a texture
+    constexpr TextureCategory getTextureCategory( TextureID texID )
+    {
+        return getTerrainType( texID ) != TerrainType::NON_TERRAIN_TEXTURE ? TextureCategory::TERRAIN : TextureCategory::INTERFACE;
     }
-
+    
     
     // This is a static class, i.e., it has some static resource maps
     // for storing various types of resources and static methods to
@@ -580,37 +521,239 @@ namespace rts
     
     class ResourceManager
     {
-
+        
+        public:
+            
+            // Location of a texture on the GPU: the texture holding it, and
+            // the rectangle it occupies inside that texture
+            struct AtlasRegion
+            {
+                const sf::Texture* m_texture;
+                sf::IntRect m_rect;
+            };
+            
+            // A texture & the file to load it from
+            struct TextureFile
+            {
+                TextureID m_id;
+                std::string m_file;
+            };
+            
+            // A font & the file to load it from
+            struct FontFile
+            {
+                FontID m_id;
+                std::string m_file;
+            };
+            
+            // The assets needed by some part of the game, e.g., a game state
+            struct AssetSet
+            {
+                std::vector<TextureFile> m_textures;
+                std::vector<FontFile> m_fonts;
+            };
+            
+            // Texture memory in use, in bytes
+            struct ResidencyStats
+            {
+                std::size_t m_bytes[static_cast<int>( TextureCategory::MAX_CATEGORIES )];
+                std::size_t m_totalBytes;
+                std::size_t m_budget;
+                
+                // Number of textures loaded & of those pinned by an asset set
+                int m_resident;
+                int m_pinned;
+            };
+            
         public:
             
+            // Open the packed asset archive. The files found in it are loaded
+            // from there, all others from their own files.
+            static bool openArchive(const std::string& archiveFile);
+            
             // Insert a new texture to the texture handle map
             static bool addTexture(const TextureID texID, const std::string& texFile);
-
-            // Get a pointer to an existin texture in the texture map
-            static std::shared_ptr<sf::Texture> getTexture(const TextureID texID);
-
+            
+            // Insert a batch of textures to the texture handle map. The files
+            // are decoded in parallel on the thread pool, only the uploads to
+            // the GPU are done on the calling thread. Textures that fail to
+            // load are skipped and reported.
+            static bool addTextures(const std::vector<TextureFile>& textures);
+            
+            // Insert a batch of fonts to the font handle map
+            static bool addFonts(const std::vector<FontFile>& fonts);
+            
+            // Load all the assets of a set before returning
+            static bool loadAssetSet(const AssetSet& assetSet);
+            
+            // Start decoding the textures of a set on the thread pool & return at
+            // once. The decoded textures are uploaded by uploadPendingTextures(),
+            // the fonts are left to be loaded once the textures are done.
+            static void requestAssetSet(const AssetSet& assetSet);
+            
+            // Upload the textures decoded in the background so far, for no longer
+            // than the budget. Must be called from the thread with the GL context.
+            static void uploadPendingTextures(const sf::Time budget);
+            
+            // Fraction of the textures of a set that have been loaded, or have
+            // failed to, from 0 to 1
+            static float getLoadingProgress(const AssetSet& assetSet);
+            
+            // Keep the textures of a set resident until the set is released,
+            // as many times as it is pinned
+            static void pinAssetSet(const AssetSet& assetSet);
+            
+            // Undo one pinAssetSet(). The textures no set holds any more stay
+            // loaded until trimTextures() needs the memory.
+            static void releaseAssetSet(const AssetSet& assetSet);
+            
+            // Set the texture memory trimTextures() keeps to, in bytes
+            static void setMemoryBudget(const std::size_t bytes);
+            
+            // Unload the textures no set has pinned, those released longest ago
+            // first, until the loaded textures fit in the budget. Must be called
+            // from the thread with the GL context.
+            static void trimTextures();
+            
+            // Get the texture memory in use per category
+            static ResidencyStats getResidencyStats();
+            
+            // Get a pointer to an existing texture, nullptr if it is not loaded.
+            // The texture stays at that address as long as a set holding it is
+            // pinned; unpinned ones may be unloaded by trimTextures().
+            static const sf::Texture* getTexture(const TextureID texID);
+            
+            // Same as getTexture(), but without reporting missing textures.
+            // Lock free & safe to call from any thread: a texture is only
+            // published once it has been fully uploaded, & only unloaded by
+            // the main thread once no set has it pinned.
+            static inline const sf::Texture* findTexture(const TextureID texID);
+            
             // Insert a new font to the texture handle map
             static bool addFont(const FontID fontID, const std::string& fontFile);
-
-            // Get a pointer to an existing font in the texture map
-            static std::shared_ptr<sf::Font> getFont(const FontID fontID);
-
+            
+            // Get a pointer to an existing font, nullptr if it is not loaded.
+            // The font stays at that address until the program exits.
+            static const sf::Font* getFont(const FontID fontID);
+            
+            // Same as getFont(), but without reporting missing fonts. Lock
+            // free & safe to call from any thread.
+            static inline const sf::Font* findFont(const FontID fontID);
+            
+            // Pack all the loaded terrain textures into as few large atlas
+            // textures as the GPU allows. Must be called after the terrain
+            // textures have been added.
+            static bool buildTerrainAtlas();
+            
+            // Get the region of a texture inside its atlas. Textures not
+            // packed into any atlas map to the whole of their own texture.
+            static AtlasRegion getAtlasRegion(const TextureID texID);
+        
         private:
             
+            // Decode an image from the archive or from its file. Safe to call
+            // from any thread once the archive is open.
+            static bool loadImage(sf::Image& image, const std::string& file);
+            
+            // Upload a decoded image to the GPU as a texture & insert it
+            static bool uploadTexture(const TextureID texID, const sf::Image& image);
+            
+            // Take ownership of a texture & publish it to the readers, unless
+            // one is already loaded under the same ID
+            static void storeTexture(const TextureID texID, std::unique_ptr<sf::Texture> texture);
+            
+            // Unpublish a texture & free its memory
+            static void evictTexture(const TextureID texID);
+            
+            // Memory taken by a texture on the GPU
+            static inline std::size_t textureBytes(const sf::Texture& texture);
+            
+            // Drop the atlas textures & the regions packed into them
+            static void clearAtlas();
+            
+            // Is the texture loaded, being loaded or failed to load?
+            static bool textureRequested(const TextureID texID);
+            
+            // A texture being decoded in the background
+            struct PendingTexture
+            {
+                TextureID m_id;
+                std::string m_file;
+                sf::Image m_image;
+                
+                // 0 while decoding, then 1 if decoded & -1 if not
+                std::atomic<int> m_status;
+            };
+            
             // Disallow creation/destruction of ResourceManager objects
             
             ResourceManager();
-
+            
             ~ResourceManager();
             
         private:
-
-            // The texture map
-            static std::map<TextureID, std::shared_ptr<sf::Texture>> m_texturesHandleMap;
-
-            // The font map
-            static std::map<FontID, std::shared_ptr<sf::Font>> m_fontsHandleMap;
+            
+            static AssetArchive m_archive;
+            
+            // The loaded textures & fonts, indexed by their ID. Only the
+            // main thread writes to them.
+            static std::unique_ptr<sf::Texture> m_textures[static_cast<int>( TextureID::MAX_TEXTURES )];
+            static std::unique_ptr<sf::Font> m_fonts[static_cast<int>( FontID::MAX_FONTS )];
+            
+            // The same textures & fonts as seen by the readers, each pointer
+            // is stored once its resource is complete
+            static std::atomic<const sf::Texture*> m_textureSlots[static_cast<int>( TextureID::MAX_TEXTURES )];
+            static std::atomic<const sf::Font*> m_fontSlots[static_cast<int>( FontID::MAX_FONTS )];
+            
+            // The textures being loaded in the background, in request order
+            static std::deque<std::shared_ptr<PendingTexture>> m_pendingTextures;
+            
+            // The textures that could not be loaded
+            static std::set<TextureID> m_failedTextures;
+            
+            // The atlas textures
+            static std::vector<std::shared_ptr<sf::Texture>> m_atlasPages;
+            
+            // Number of times each texture is pinned
+            static int m_pinCount[static_cast<int>( TextureID::MAX_TEXTURES )];
+            
+            // When each texture was last loaded or released by a set, on
+            // the clock below, to unload the least recently used first
+            static unsigned long m_lastUsed[static_cast<int>( TextureID::MAX_TEXTURES )];
+            static unsigned long m_useClock;
+            
+            // Texture memory in use per category & the budget for it
+            static std::size_t m_residentBytes[static_cast<int>( TextureCategory::MAX_CATEGORIES )];
+            static std::size_t m_memoryBudget;
+            
+            // The regions of the textures packed into the atlas textures,
+            // indexed by TextureID, with no texture for those not packed
+            static AtlasRegion m_atlasRegions[static_cast<int>( TextureID::MAX_TEXTURES )];
     };
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////
+    
+    inline const sf::Texture* ResourceManager::findTexture(const TextureID texID)
+    {
+        if (!isValidTexture(texID))
+            return nullptr;
+        
+        return m_textureSlots[static_cast<int>( texID )].load( std::memory_order_acquire );
+    }
+    
+    inline std::size_t ResourceManager::textureBytes(const sf::Texture& texture)
+    {
+        // 32 bits per pixel
+        return static_cast<std::size_t>( texture.getSize().x ) * texture.getSize().y * 4;
+    }
+    
+    inline const sf::Font* ResourceManager::findFont(const FontID fontID)
+    {
+        if (!isValidFont(fontID))
+            return nullptr;
+        
+        return m_fontSlots[static_cast<int>( fontID )].load( std::memory_order_acquire );
+    }
 
 }
 
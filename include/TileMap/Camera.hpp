@@ -0,0 +1,90 @@
+/*
+ * ------------------------------
+ *  Module    : TileMap
+ *  Submodule : Camera
+ * ------------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 15-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  This module contains the camera used to look at & scroll
+ *  over the tile map.
+ * 
+ */
+
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+namespace rts
+{
+    namespace WorldEntities
+    {
+        // A view of the world that scrolls with a velocity and never
+        // shows anything outside of a bounding rectangle.
+        //
+        // The camera is moved on every update but only handed to the
+        // render target when it has moved since the last time. It keeps
+        // its position before the last update as well, so that frames
+        // drawn between two updates can show it in between.
+        class Camera
+        {
+            public:
+                
+                Camera( const sf::Vector2f size, const sf::Vector2f center );
+                
+                // The rectangle of the world the view must stay inside of
+                void setBounds( const sf::FloatRect& bounds );
+                
+                // Direction to scroll in, -1, 0 or 1 along each axis
+                void setScrollDirection( const sf::Vector2f direction );
+                
+                // Accelerate towards the scroll speed in the scroll
+                // direction & move the view by the velocity
+                void update( const sf::Time dt );
+                
+                // Set the view on the target if it has moved
+                void apply( sf::RenderTarget& target );
+                
+                const sf::View& getView() const;
+                
+                // Center of the view before the last update
+                sf::Vector2f getPreviousCenter() const;
+                
+                // The rectangle of the world seen through the view
+                sf::FloatRect getViewRect() const;
+            
+            private:
+                
+                // Move the center of the view inside the bounds, stopping
+                // the camera along the axes where it hit them
+                void clamp();
+            
+            private:
+                
+                sf::View m_view;
+                
+                sf::Vector2f m_previousCenter;
+                
+                sf::FloatRect m_bounds;
+                
+                sf::Vector2f m_direction;
+                
+                // In pixels per second
+                sf::Vector2f m_velocity;
+                
+                // Set when the view has changed since it was last applied
+                bool m_moved;
+        };
+    }
+}
+
+#endif // CAMERA_HPP
@@ -16,14 +16,23 @@
 #ifndef TILE_MAP_HPP
 #define TILE_MAP_HPP
 
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
-#include <bitset>
 
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include "Utility/TripleBuffer.hpp"
+#include "ResourceManager/ResourceManager.hpp"
+#include "AnimationManager/AnimationManager.hpp"
+#include "TileMap/Camera.hpp"
 
 namespace rts
 {
@@ -32,123 +41,338 @@ namespace rts
         // Number of terrains in the world
         constexpr int TERRAIN_COUNT = 4;
         
-        // Abstracts the concept of a single 2:1  isometric tile
-        class Tile : public sf::Drawable, sf::Transformable
+        // Abstracts the concept of a single 2:1 isometric tile.
+        //
+        // A tile is a compact record: the map keeps all of them in one flat
+        // array and generates their vertices from these fields when drawing,
+        // so no per-tile vertex arrays or heap blocks exist.
+        struct Tile
         {
             public:
                 
-                typedef std::shared_ptr<Tile> Ptr;
+                // Bit mask with one bit for each of the four sides (N/E/S/W)
+                // or the four corners (NE/SE/SW/NW) of a tile
+                typedef std::uint8_t NeighborMask;
                 
-                static std::map<TerrainType, int> m_precedences;
+                enum Flags
+                {
+                    ANIMATED    = 1 << 0
+                };
                 
-                static TextureID getOverlayTexture( const std::string& id );
+                // Precedence of a terrain, a terrain is overlaid on its
+                // neighbors of lower precedence
+                static inline int precedence( const TerrainType type );
                 
-                std::bitset<4> m_neighborsStraight[TERRAIN_COUNT];// - 1];
+                // The overlay texture for the neighbors of a terrain of precedence
+                // terrainPrec lying on the sides (overlay 0) or the corners (overlay 1)
+                // of a tile set in mask, INVALID if there is none
+                static inline TextureID getOverlayTexture( const int terrainPrec, const int overlay, const NeighborMask mask );
                 
-                std::bitset<4> m_neighborsDiagonal[TERRAIN_COUNT];// - 1];
-                                
             public:
                 
-                Tile( );
-                
-                ~Tile();
-                
-                inline void setPosition( const sf::Vector2f position );
-            
-                // Get the position of a tile w.r.t. to one of the four vertices (0-3)
-                inline const sf::Vector2f getPosition( int vertex );
-                
-                inline void setFillColor( const sf::Color fillColor );
-                
-                inline bool contains( const sf::Vector2f mouse );
+                Tile();
                 
                 inline void setTexture( const TextureID texID );
                 
-                /* If skip is TRUE, then the tile is not rendered */
-                inline void skipRender( bool skip );
-                
-                inline bool inWorldView( const sf::View worldView ) const;
+                inline TextureID getTexture() const;
                 
                 inline void setAnimated( bool animated = false );
                 
                 inline bool tileAnimated() const;
                 
-                sf::VertexArray* getQuad();
-                
                 inline void setType( TerrainType terrainType );
                 
-                inline TerrainType getType();
+                inline TerrainType getType() const;
                 
                 inline void setOverlayTexture( const int terrainPrec, const int overlay, TextureID texID );
                 
-            private:
-                
-                virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
-            
-            private:
-                
-                // A set of 4 vertices to represent a 2:1 isometric tile
-                sf::VertexArray m_tileQuad;
-                
-                // One for the N/E/S/W overlays (henceforth referred to as `straight`)
-                // One for the NE/SE/SW/NW overlays (henceforth referred to as `diagonal`)
-                
-                //sf::VertexArray m_overlayQuad[2];
-                sf::VertexArray m_overlayQuad[TERRAIN_COUNT - 1][2];
-                
-                // Texture of the tile
-                sf::Texture* m_tileTexPtr;
+            public:
                 
-                //sf::Texture* m_overlayTexPtr[2];
-                sf::Texture* m_overlayTexPtr[TERRAIN_COUNT - 1][2];
+                // Base texture of the tile
+                TextureID m_texture;
                 
-                bool m_inView;
-                                
-                bool m_animated;
+                // One overlay for the N/E/S/W sides (henceforth referred to as `straight`)
+                // and one for the NE/SE/SW/NW corners (henceforth referred to as `diagonal`)
+                // for each terrain that can be drawn over another.
+                TextureID m_overlays[TERRAIN_COUNT - 1][2];
                 
                 TerrainType m_type;
+                
+                // Combination of the Flags above
+                std::uint8_t m_flags;
+        };
+        
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        
+        // Side of a square chunk of tiles, in tiles
+        constexpr int TILE_CHUNK_SIZE = 16;
+        
+        // Number of chunks whose vertex arrays are kept in memory, the ones
+        // seen least recently are released beyond it
+        constexpr int TILE_CHUNK_BUDGET = 128;
+        
+        // Draw layers of a chunk: the base terrain, followed
+        // by the overlays of each terrain precedence above it
+        constexpr int TILE_CHUNK_LAYERS = TERRAIN_COUNT;
+        
+        // A square block of tiles whose quads are pre-built into one vertex
+        // array per layer and atlas texture. The arrays are built when the
+        // chunk first comes into view, rebuilt only when a tile inside it
+        // changes, and released when it has been out of view for long.
+        struct TileChunk
+        {
+            typedef std::map<const sf::Texture*, sf::VertexArray> Layer;
+            
+            Layer m_layers[TILE_CHUNK_LAYERS];
+            
+            // Base quads of the animated tiles, drawn along with layer 0
+            Layer m_animated;
+            
+            // Set when a tile inside the chunk has changed
+            bool m_dirty;
+            
+            // Texture offset the animated quads were last synced to
+            float m_animationOffset;
+            
+            // Set while the vertex arrays of the chunk are built
+            bool m_resident;
+            
+            // The last frame the chunk was in view
+            unsigned m_lastVisible;
+        };
+        
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        
+        // The tiles whose quads overlap a rectangle of the world.
+        //
+        // In the isometric projection a rectangle of the world is a band of
+        // x - y (horizontal extent) crossed with a band of x + y (vertical
+        // extent), so the tiles form a range of rows, each with a single
+        // range of columns.
+        struct TileRange
+        {
+            // First row of the range and one past the last one
+            int m_rowBegin;
+            int m_rowEnd;
+            
+            // First column of a row in the range and one past the last one
+            inline int columnBegin( const int row ) const;
+            inline int columnEnd( const int row ) const;
+            
+            // Bounds of x - y and x + y of the tiles in the range
+            int m_diffMin, m_diffMax;
+            int m_sumMin, m_sumMax;
+            
+            // Number of tiles on a side of the map
+            int m_size;
+        };
+        
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        
+        // What the map looks like after an update, handed from the
+        // thread updating the map to the one drawing it
+        struct TileMapSnapshot
+        {
+            sf::View m_view;
+            
+            // Center of the view before the update, to blend from
+            sf::Vector2f m_previousCenter;
+            
+            // The tile under the mouse, (-1, -1) if none
+            sf::Vector2i m_hoveredTile;
+        };
+        
+        // A tile changed by an update, at m_tiles[m_index]
+        struct TileChange
+        {
+            int m_index;
+            Tile m_tile;
         };
         
         ///////////////////////////////////////////////////////////////////////////////////////////
         
         // Abstracts the implementation of a n isometric tile map using the above tile type
+        //
+        // The map is split in two halves that may live on different threads:
+        // the tiles & the camera are updated by update(), which publishes a
+        // snapshot of the view & the tiles it changed; the chunks are built
+        // from those by prepareFrame() on the thread drawing the map.
         class TileMap : public sf::Drawable, sf::Transformable
         {
             public:
                 
-                //TileMap();
-                
                 TileMap( const int size, sf::RenderWindow& window );
                 
                 ~TileMap();
                 
-                //bool generate( const int size, sf::RenderWindow& window );
-                
+                // Sample the mouse for the next update. Must be called from the
+                // thread with the window, while update() is not running.
                 void handleInput();
+                
+                // Paint & scroll the map, then publish the result for drawing
                 void update( const sf::Time dt );
                 
+                // Bring the chunks & the view up to the latest published update,
+                // with the view blended by alpha from where it was before it.
+                // Must be called from the thread drawing the map, before drawing it.
+                void prepareFrame( const float alpha );
+                
                 void setSelectedTile( const TextureID texID );
                 
+                // Set the texture of the tile at column x, row y and update the
+                // overlays of the tile and its neighbors
+                void paintTile( const int x, const int y, const TextureID texID );
+                
+                // Resolve the overlays of the tiles in an area of the map from the
+                // terrains around them, e.g., after the area has been changed or loaded
+                void autotile( const sf::IntRect& area );
+                
+                // The area of the map whose tiles changed up to the last update,
+                // empty if none. Whatever caches data derived from the tiles
+                // (e.g., a minimap or path costs) pulls it once per frame and
+                // refreshes only that area.
+                const sf::IntRect& changedArea() const;
+                
             private:
                 
                 virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
                 
+                // The tile at column x, row y
+                inline Tile& tile( const int x, const int y );
+                inline const Tile& tile( const int x, const int y ) const;
+                
+                // The tile at column x, row y as last seen by prepareFrame()
+                inline const Tile& renderTile( const int x, const int y ) const;
+                
+                // Position of the top vertex (0) of the tile at column x, row y
+                inline sf::Vector2f tilePosition( const int x, const int y ) const;
+                
+                // The tiles overlapping a rectangle of the world, found by inverting the
+                // isometric projection, i.e., without visiting the tiles outside of it
+                TileRange tilesInRect( const sf::FloatRect& rect ) const;
+                
+                // Diamond hit test for the tile at column x, row y
+                bool tileContains( const int x, const int y, const sf::Vector2f point ) const;
+                
+                // Find the tile under a point of the world by inverting the isometric
+                // projection, false if the point is not over any tile of the map
+                bool tileAt( const sf::Vector2f point, sf::Vector2i& tilePos ) const;
+                
+                // Build the quad of the tile at column x, row y
+                void buildQuad( const int x, const int y, sf::Vertex* quad ) const;
+                
+                // Append a quad to a layer, mapping it to the atlas region of a texture
+                void appendQuad( TileChunk::Layer& layer, const TextureID texID, const sf::Vertex* quad ) const;
+                
+                // The chunk at chunk column cx, chunk row cy
+                inline TileChunk& chunk( const int cx, const int cy );
+                
+                // Record a change to the tile at column x, row y
+                void markDirty( const int x, const int y );
+                
+                // Queue the tiles changed during an update for prepareFrame()
+                void publishChanges();
+                
+                // Regenerate the vertex arrays of a chunk from its tiles
+                void rebuildChunk( const int cx, const int cy );
+                
+                // Bring the animated quads of a chunk to the current animation frame
+                void syncAnimatedQuads( TileChunk& tileChunk );
+                
+                // Release the vertex arrays of the chunks seen least recently,
+                // down to the residency budget
+                void evictChunks();
+                
+            private:
+                
+                // The mouse as sampled by handleInput()
+                struct MouseInput
+                {
+                    // Is the mouse over the map rather than over the UI?
+                    bool m_overMap;
+                    
+                    sf::Vector2i m_screenPos;
+                    sf::Vector2f m_worldPos;
+                    
+                    bool m_down;
+                };
+                
             private:
                 
                 int m_size;
                 
-                // The 2D array of tiles in the map
-                // NOTE: I'm well aware of the fact that
-                // this is the most naive technique for
-                // storing a tile based map
-                std::vector<std::vector<Tile::Ptr>> m_tiles;
+                // Position of the top vertex of tile (0,0)
+                sf::Vector2f m_gridPos;
+                
+                /* The updating half */
+                
+                // The tiles of the map, stored row-major in a
+                // single contiguous block, i.e., the tile at
+                // column x, row y is m_tiles[y * m_size + x]
+                std::vector<Tile> m_tiles;
+                
+                MouseInput m_input;
+                
+                // Bounds of the tiles changed since the last update, and
+                // those published for the current frame
+                sf::IntRect m_dirtyArea;
+                sf::IntRect m_changedArea;
                 
                 // The selected tile
                 TextureID m_selectedTile;
                 
-                sf::RenderWindow* m_window;
+                Camera m_camera;
+                
+                /* Handed from the updating half to the drawing one */
+                
+                TripleBuffer<TileMapSnapshot> m_snapshots;
+                
+                // The tiles changed by the updates not yet taken in by
+                // prepareFrame(). They are queued rather than put into the
+                // snapshots, which may be skipped.
+                std::vector<TileChange> m_changes;
+                std::mutex m_changesMutex;
+                
+                /* The drawing half */
+                
+                // The tiles as of the latest update prepareFrame() took in
+                std::vector<Tile> m_renderTiles;
                 
-                sf::View m_mapView;
+                // The changes being taken in, kept for their storage
+                std::vector<TileChange> m_renderChanges;
+                
+                // The chunks of the map, stored row-major
+                // like the tiles, m_chunkCount to a side
+                std::vector<TileChunk> m_chunks;
+                
+                int m_chunkCount;
+                
+                // Chunks that overlapped the view at the last frame
+                std::vector<int> m_visibleChunks;
+                
+                // Chunks whose vertex arrays are built
+                std::vector<int> m_residentChunks;
+                
+                // Number of frames so far, to date the visits to the chunks
+                unsigned m_frame;
+                
+                // Texture x-offset of the current frame of the animated
+                // tiles w.r.t. the first one, read from their animation
+                float m_animationOffset;
+                
+                AnimationManager::AnimationHandle m_animation;
+                
+                // Atlas regions of the textures used by the tiles, indexed by TextureID
+                std::vector<ResourceManager::AtlasRegion> m_regions;
+                
+                // The tile under the mouse, (-1, -1) if none
+                sf::Vector2i m_hoveredTile;
+                
+                // Shade drawn over the tile under the mouse, so that
+                // hovering never touches the vertices of the chunks
+                sf::VertexArray m_hoverQuad;
+                
+                sf::RenderWindow* m_window;
         };
     }
 }
@@ -19,10 +19,15 @@
 #ifndef C_UI_CAPTION_HPP
 #define C_UI_CAPTION_HPP
 
+#include <limits>
+#include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
-#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/String.hpp>
 
 #include "UI/Components/C_ComponentBase.hpp"
 
@@ -32,6 +37,119 @@ namespace rts
     {
         namespace UIComponent
         {
+            // A string laid out with a font & a character size: two triangles
+            // for every visible glyph, placed the same way sf::Text places them.
+            struct GlyphRun
+            {
+                // The layout state before a character
+                struct Step
+                {
+                    // Index of the first vertex of the character
+                    std::size_t m_vertex;
+                    
+                    // Pen position, before the kerning with the previous character
+                    sf::Vector2f m_pen;
+                    
+                    // Bounds of the characters before it
+                    float m_minX, m_minY, m_maxX, m_maxY;
+                };
+                
+                // White, the color is applied by the text showing the run
+                std::vector<sf::Vertex> m_vertices;
+                
+                // One step for every character & one past the last, so that
+                // the layout can be resumed after any unchanged prefix
+                std::vector<Step> m_steps;
+                
+                sf::FloatRect m_bounds;
+            };
+            
+            ///////////////////////////////////////////////////////////////////////////////////////////
+            
+            // A drop-in for sf::Text whose glyph runs are cached on (font,
+            // size, string) & shared between all the texts showing the same
+            // string. A new string is laid out from the first character that
+            // differs from the old one, so counters & timers only rebuild the
+            // glyphs that changed. The geometry is updated lazily, on the next
+            // draw or bounds query.
+            class CaptionText : public sf::Drawable,
+                                public sf::Transformable
+            {
+                public:
+                    
+                    CaptionText();
+                    
+                    void setString( const sf::String& string );
+                    
+                    void setFont( const sf::Font& font );
+                    
+                    void setCharacterSize( const unsigned size );
+                    
+                    void setFillColor( const sf::Color& color );
+                    
+                    const sf::String& getString() const;
+                    
+                    const sf::Font* getFont() const;
+                    
+                    unsigned getCharacterSize() const;
+                    
+                    const sf::Color& getFillColor() const;
+                    
+                    sf::FloatRect getLocalBounds() const;
+                    
+                    sf::FloatRect getGlobalBounds() const;
+                    
+                private:
+                    
+                    // Cache key of a glyph run
+                    struct RunKey
+                    {
+                        const sf::Font* m_font;
+                        unsigned m_size;
+                        sf::String m_string;
+                        
+                        bool operator<( const RunKey& other ) const;
+                    };
+                    
+                    virtual void draw( sf::RenderTarget& target, sf::RenderStates states ) const;
+                    
+                    // Switch to the run of the current string & rewrite the
+                    // vertices from the first character that changed
+                    void ensureGeometryUpdate() const;
+                    
+                    // Find the run of a string in the cache or lay it out, reusing
+                    // the first `reuse` characters of a run of the same font & size
+                    static std::shared_ptr<const GlyphRun> findRun( const sf::Font& font,
+                                                                    const unsigned size,
+                                                                    const sf::String& string,
+                                                                    const GlyphRun* previous,
+                                                                    std::size_t reuse );
+                    
+                private:
+                    
+                    static constexpr std::size_t CLEAN = std::numeric_limits<std::size_t>::max();
+                    
+                    sf::String m_string;
+                    
+                    const sf::Font* m_font;
+                    
+                    unsigned m_charSize;
+                    
+                    sf::Color m_color;
+                    
+                    // The run of the string & its vertices in the fill color
+                    mutable std::shared_ptr<const GlyphRun> m_run;
+                    mutable std::vector<sf::Vertex> m_vertices;
+                    
+                    // The first character changed since the last update, CLEAN if none
+                    mutable std::size_t m_changedFrom;
+                    
+                    // The glyph runs laid out recently
+                    static std::map<RunKey, std::shared_ptr<const GlyphRun>> m_runCache;
+            };
+            
+            ///////////////////////////////////////////////////////////////////////////////////////////
+            
             struct C_UICaption : public C_ComponentBase
             {
                 typedef std::shared_ptr<C_UICaption> Ptr;
@@ -44,7 +162,7 @@ namespace rts
                 void draw(sf::RenderTarget& target, sf::RenderStates states) const;
                 
                 /* The text element of the caption */
-                sf::Text m_text;
+                CaptionText m_text;
             };
         }
     }
@@ -18,6 +18,7 @@
 #ifndef CONSTANTS_HPP
 #define CONSTANTS_HPP
 
+#include <cstddef>
 #include <string>
 
 #include <SFML/System/Time.hpp>
@@ -33,6 +34,7 @@ namespace rts
     const std::string PATH_UI_TEXTURES  = PATH_TEXTURES + "ui/";
     const std::string PATH_FONTS        = PATH_ASSETS   + "fonts/";
     const std::string PATH_TERRAIN_TEXTURES  = PATH_TEXTURES + "world/terrain/";
+    const std::string PATH_ANIMATIONS   = PATH_ASSETS   + "animations/";
     
     ////////////////////
     // Resource files //
@@ -245,6 +247,26 @@ namespace rts
     const std::string FONT_ROBOTO_BOLD                   = "Roboto-Bold.ttf";
     const std::string FONT_SOURCE_HAN_SANS_CN_NORMAL     = "Source-Han-Sans-CN-Normal.otf";
     
+    /* -------------------
+     *  Animation clips
+     * -------------------
+     * 
+     * The frames of all animations, see AnimationManager::loadClips()
+     * for the format.
+     */
+    
+    const std::string ANIMATION_CLIPS = "clips.txt";
+    
+    /* ---------------
+     *  Asset archive
+     * ---------------
+     * 
+     * The textures & fonts packed into one file at build time by
+     * tools/PackAssets.cpp, loaded in place of the files above.
+     */
+    
+    const std::string ASSET_ARCHIVE = "assets.pak";
+    
     
     ///////////////////
     // GUI constants //
@@ -258,6 +280,9 @@ namespace rts
     // Default character size of a Caption component
     const int UI_DEFAULT_CAPTION_CHAR_SIZE = 10;
     
+    // Number of laid out strings kept for reuse by the captions
+    const std::size_t UI_CAPTION_RUN_CACHE_SIZE = 256;
+    
     // Default texture size for a default UI button
     const int UI_DEFAULT_BUTTON_TEXTURE_WIDTH  = 30;
     const int UI_DEFAULT_BUTTON_TEXTURE_HEIGHT = 30;
@@ -312,6 +337,20 @@ namespace rts
     // Frame rate constants
     const float    FRAMES_PER_SECOND = 60.f;
     const sf::Time FRAME_TIME        = sf::seconds( 1.f / FRAMES_PER_SECOND );
+    
+    // Update the states that allow it on a thread of their own, so that the
+    // simulation keeps its rate however long the frames take to draw
+    const bool SIMULATION_THREAD = false;
+    
+    // Time a frame may spend uploading textures loaded in the background
+    const sf::Time TEXTURE_UPLOAD_BUDGET = sf::milliseconds( 4 );
+    
+    // Texture memory the textures no state uses are unloaded to stay within, in bytes
+    const std::size_t TEXTURE_MEMORY_BUDGET = 256 * 1024 * 1024;
+    
+    // Map scrolling constants, in pixels per second (squared)
+    const float CAMERA_SCROLL_SPEED        = 350.f;
+    const float CAMERA_SCROLL_ACCELERATION = 2800.f;
 }
 
 #endif // CONSTANTS_HPP
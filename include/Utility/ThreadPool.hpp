@@ -0,0 +1,88 @@
+/*
+ * -------------------------
+ *  Module    : Utility
+ *  Submodule : ThreadPool
+ * -------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 01-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  A pool of worker threads to spread work over the cores.
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rts
+{
+    // A fixed number of worker threads running the tasks handed to them.
+    //
+    // The workers never touch the logger or SFML objects shared with the
+    // main thread, the tasks given to them must not either.
+    class ThreadPool
+    {
+        public:
+            
+            // The pool shared by the whole game, with a worker for
+            // each core besides the one of the main thread
+            static ThreadPool& getInstance();
+            
+        public:
+            
+            explicit ThreadPool( const unsigned workers );
+            
+            // Waits for the running tasks & drops the queued ones
+            ~ThreadPool();
+            
+            ThreadPool( const ThreadPool& ) = delete;
+            ThreadPool& operator= ( const ThreadPool& ) = delete;
+            
+            unsigned getWorkerCount() const;
+            
+            // Queue a task to run on a worker, returning at once. Without
+            // any workers the task is run on the calling thread instead.
+            void submit( std::function<void()> task );
+            
+            // Run job over [0, count) split into chunks of grain items, on the
+            // workers & the calling thread, returning once all chunks are done.
+            //
+            // The chunks depend only on count & grain, never on the number of
+            // workers, so a job whose chunks write to disjoint data gives the
+            // same result on any number of threads.
+            void parallelFor( const std::size_t count,
+                              const std::size_t grain,
+                              const std::function<void( std::size_t begin, std::size_t end )>& job );
+            
+        private:
+            
+            // Loop of a worker, running tasks until the pool is destroyed
+            void work();
+            
+        private:
+            
+            std::vector<std::thread> m_workers;
+            
+            std::deque<std::function<void()>> m_tasks;
+            
+            // Guards the tasks & the stopping flag
+            std::mutex m_mutex;
+            
+            // Signalled when a task is queued or the pool is stopping
+            std::condition_variable m_wake;
+            
+            bool m_stopping;
+    };
+}
+
+#endif // THREAD_POOL_HPP
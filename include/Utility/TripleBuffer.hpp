@@ -0,0 +1,107 @@
+/*
+ * ---------------------------
+ *  Module    : Utility
+ *  Submodule : TripleBuffer
+ * ---------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 01-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  A lock free triple buffer to hand values from one thread to another.
+ */
+
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+namespace rts
+{
+    // Three copies of a value: one being written, one being read & the
+    // latest one published in between. The writer & the reader never wait
+    // on each other; the reader always gets the latest value published,
+    // values it is too slow to see are skipped.
+    //
+    // There must be exactly one writer thread & one reader thread.
+    template <typename T>
+    class TripleBuffer
+    {
+        public:
+            
+            TripleBuffer();
+            
+            // The value to fill in before publishing it. Writer only.
+            T& back();
+            
+            // Hand the back value to the reader & start on another one, which
+            // holds an older value & must be filled in anew. Writer only.
+            void publish();
+            
+            // Switch to the latest published value, false if there is none
+            // since the last time. Reader only.
+            bool fetch();
+            
+            // The value fetched last. Reader only.
+            const T& front() const;
+        
+        private:
+            
+            // Set in the middle index when it holds a value the reader has not fetched
+            static constexpr int FRESH = 4;
+            
+            T m_values[3];
+            
+            int m_back;
+            int m_front;
+            std::atomic<int> m_middle;
+    };
+    
+    ///////////////////////////////////////////////////////////////////////////////////////////
+    
+    template <typename T>
+    constexpr int TripleBuffer<T>::FRESH;
+    
+    template <typename T>
+    TripleBuffer<T>::TripleBuffer() :
+     m_back( 0 ),
+     m_front( 1 ),
+     m_middle( 2 )
+    {
+    }
+    
+    template <typename T>
+    T& TripleBuffer<T>::back()
+    {
+        return m_values[m_back];
+    }
+    
+    template <typename T>
+    void TripleBuffer<T>::publish()
+    {
+        // Release the writes to the back value, acquire the reads of the
+        // value handed back so it is not written to while still being read
+        m_back = m_middle.exchange( m_back | FRESH, std::memory_order_acq_rel ) & ~FRESH;
+    }
+    
+    template <typename T>
+    bool TripleBuffer<T>::fetch()
+    {
+        if ( !( m_middle.load( std::memory_order_relaxed ) & FRESH ) )
+            return false;
+        
+        m_front = m_middle.exchange( m_front, std::memory_order_acq_rel ) & ~FRESH;
+        
+        return true;
+    }
+    
+    template <typename T>
+    const T& TripleBuffer<T>::front() const
+    {
+        return m_values[m_front];
+    }
+}
+
+#endif // TRIPLE_BUFFER_HPP
@@ -41,8 +41,12 @@ namespace rts
         {
             /*
              * The AnimationComponent needs access to the sprite of the
-             * entity for animation, along with other required parameters
-             * like frametime etc.
+             * entity for animation.
+             * 
+             * What is shown on the sprite is described by an animation
+             * clip & the state of a running animation (the time it started
+             * at etc.) is kept by the AnimationManager, so the component
+             * holds nothing but the sprite.
              */
             struct AnimationComponent
             {
@@ -50,19 +54,18 @@ namespace rts
                     
                     typedef std::shared_ptr<AnimationComponent> Ptr;
                     
+                    // One without a renderable, whose owner reads the
+                    // current frame when drawing instead
                     AnimationComponent();
                     
                     // One using sf::Sprite as the renderable
-                    AnimationComponent( sf::Sprite* entitySprite,
-                                        const sf::Vector2i frameSize,
-                                        const unsigned maxFrame,
-                                        const sf::Time duration );
+                    AnimationComponent( sf::Sprite* entitySprite );
                     
                     // One using sf::VertexArray as the renderable
-                    AnimationComponent( sf::VertexArray* vertexArray,
-                                        const sf::Vector2i frameSize,
-                                        const unsigned maxFrame,
-                                        const sf::Time duration );
+                    AnimationComponent( sf::VertexArray* vertexArray );
+                    
+                    // Show a frame, given by its texture rect, on the sprite of the entity
+                    void setFrame( const sf::IntRect& frame );
                     
                     // The sprite of the entity
                     
@@ -80,29 +83,6 @@ namespace rts
                         sf::Sprite* m_spritePtr;
                         sf::VertexArray* m_vertexArrayPtr;
                     } m_entitySprite;
-                    
-                    // The texture rect for the sprite of the entity
-                    sf::IntRect m_textureRect;
-                    
-                    // The width x height of each frame
-                    sf::Vector2i m_frameSize;
-                    
-                    // The current frame number of the animation
-                    int m_currentFrame;
-                    
-                    // The maximum frame number of the animation
-                    int m_maxFrame;
-                    
-                    // The duration (in seconds) of each frame of the animation
-                    sf::Time m_duration;
-                    
-                    // Time elapsed since the last frame change occurred
-                    sf::Time m_elapsedTime;
-                    
-                    // Loop the animation?
-                    bool m_loop;
-                    
-                    bool m_visible;
             };
         }
     }
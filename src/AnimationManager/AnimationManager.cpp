@@ -1,181 +1,513 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
 #include "Utility/System.hpp"
 #include "Utility/Log.hpp"
+#include "Utility/ThreadPool.hpp"
 #include "AnimationManager/AnimationManager.hpp"
 
 namespace rts
 {
     namespace AnimationManager
     {
-        std::map<std::string, WorldEntities::EntityComponents::AnimationComponent::Ptr> AnimationManager::m_animations = {};
+        std::vector<AnimationManager::Slot> AnimationManager::m_slots = {};
+        std::vector<std::uint32_t> AnimationManager::m_freeSlots = {};
+        std::vector<WorldEntities::EntityComponents::AnimationComponent> AnimationManager::m_components = {};
+        std::vector<std::uint32_t> AnimationManager::m_groups = {};
+        std::vector<bool> AnimationManager::m_visible = {};
+        std::vector<bool> AnimationManager::m_lazy = {};
+        std::vector<std::uint32_t> AnimationManager::m_owners = {};
+        std::vector<std::string> AnimationManager::m_labels = {};
+        std::vector<int> AnimationManager::m_shownFrames = {};
+        std::vector<sf::FloatRect> AnimationManager::m_bounds = {};
+        std::vector<unsigned> AnimationManager::m_visits = {};
+        std::vector<std::uint32_t> AnimationManager::m_pending = {};
+        std::vector<AnimationClip> AnimationManager::m_clips = {};
+        std::vector<sf::Time> AnimationManager::m_groupStarts = {};
+        std::vector<int> AnimationManager::m_groupFrames = {};
+        sf::Time AnimationManager::m_now = sf::Time::Zero;
+        constexpr float AnimationManager::CELL_SIZE;
+        constexpr std::size_t AnimationManager::UPDATE_GRAIN;
+        std::map<std::pair<int, int>, std::vector<std::uint32_t>> AnimationManager::m_cells = {};
+        std::vector<std::uint32_t> AnimationManager::m_unbounded = {};
+        sf::FloatRect AnimationManager::m_viewRect = {};
+        bool AnimationManager::m_culling = false;
+        unsigned AnimationManager::m_updates = 0;
+        
+        bool AnimationManager::exists( const AnimationHandle handle )
+        {
+            return indexOf( handle ) >= 0;
+        }
         
-        bool AnimationManager::exists( const std::string& id )
+        bool AnimationManager::loadClips( const std::string& path )
         {
-            if ( isStrWS( id ) )
+            std::ifstream file( path );
+            if ( !file.is_open() )
             {
-                LOG(Logger::Level::ERROR) << "Invalid ID used access an AnimationComponent instance." << std::endl;
+                LOG(Logger::Level::ERROR) << "Unable to open animation clips file: " << path << std::endl;
                 return false;
             }
             
-            return m_animations.find( id ) != m_animations.end();
+            std::vector<AnimationClip> clips;
+            
+            std::string line;
+            int lineNumber = 0;
+            
+            while ( std::getline( file, line ) )
+            {
+                ++lineNumber;
+                
+                std::istringstream stream( line );
+                std::string keyword;
+                
+                if ( !( stream >> keyword ) || keyword[0] == '#' )
+                    continue;
+                
+                if ( keyword == "clip" )
+                {
+                    AnimationClip clip;
+                    std::string mode;
+                    
+                    if ( !( stream >> clip.m_name >> mode ) || ( mode != "loop" && mode != "once" ) )
+                    {
+                        LOG(Logger::Level::ERROR) << path << ":" << lineNumber << ": Expected `clip <name> <loop|once>`." << std::endl;
+                        return false;
+                    }
+                    
+                    clip.m_loop = mode == "loop";
+                    clips.push_back( clip );
+                }
+                else if ( keyword == "frame" )
+                {
+                    sf::IntRect rect;
+                    int milliseconds;
+                    
+                    if ( clips.empty() ||
+                         !( stream >> rect.left >> rect.top >> rect.width >> rect.height >> milliseconds ) ||
+                         milliseconds <= 0 )
+                    {
+                        LOG(Logger::Level::ERROR) << path << ":" << lineNumber << ": Expected `frame <left> <top> <width> <height> <duration in ms>` inside a clip." << std::endl;
+                        return false;
+                    }
+                    
+                    AnimationClip& clip = clips.back();
+                    sf::Time end = clip.m_frameEnds.empty() ? sf::Time::Zero : clip.m_frameEnds.back();
+                    
+                    clip.m_frames.push_back( rect );
+                    clip.m_frameEnds.push_back( end + sf::milliseconds( milliseconds ) );
+                }
+                else
+                {
+                    LOG(Logger::Level::ERROR) << path << ":" << lineNumber << ": Unknown keyword `" << keyword << "`." << std::endl;
+                    return false;
+                }
+            }
+            
+            for ( auto&& clip : clips )
+            {
+                if ( clip.m_frames.empty() )
+                {
+                    LOG(Logger::Level::ERROR) << "Animation clip " << clip.m_name << " has no frames, skipped." << std::endl;
+                    continue;
+                }
+                
+                if ( getClip( clip.m_name ) >= 0 )
+                {
+                    LOG(Logger::Level::ERROR) << "Animation clip " << clip.m_name << " already loaded, skipped." << std::endl;
+                    continue;
+                }
+                
+                // Every clip has a group of its own
+                m_clips.push_back( clip );
+                m_groupStarts.push_back( m_now );
+                m_groupFrames.push_back( 0 );
+            }
+            
+            LOG(Logger::Level::DEBUG) << "Loaded animation clips from " << path << ", " << m_clips.size() << " clips in total." << std::endl;
+            
+            return true;
         }
         
-        bool AnimationManager::createAnimation( const std::string& id        ,
-                                                sf::Sprite* entitySprite     ,
-                                                const sf::Vector2i frameSize ,
-                                                const unsigned maxFrame      ,
-                                                const sf::Time frameDuration )
+        int AnimationManager::getClip( const std::string& name )
         {
-            if ( isStrWS( id ) )
+            for ( std::size_t c = 0; c < m_clips.size(); ++c )
             {
-                LOG(Logger::Level::ERROR) << "Invalid ID used to create a new AnimationComponent instance." << std::endl;
-                return false;
+                if ( m_clips[c].m_name == name )
+                    return static_cast<int>( c );
             }
             
-            auto it = m_animations.find( id );
-            if ( it != m_animations.end() )
+            return -1;
+        }
+        
+        AnimationHandle AnimationManager::createAnimation( sf::Sprite* entitySprite     ,
+                                                           const int clip               ,
+                                                           const std::string& label )
+        {
+            if ( !entitySprite )
             {
-                LOG(Logger::Level::ERROR) << "An AnimationComponent with ID(" + id + ") already exists." << std::endl;
-                return false;
+                LOG(Logger::Level::ERROR) << "Invalid sprite used to create a new AnimationComponent instance." << std::endl;
+                return AnimationHandle{};
             }
             
-            m_animations[id] = std::make_shared<WorldEntities::EntityComponents::AnimationComponent>( entitySprite, frameSize, maxFrame, frameDuration );
-            LOG(Logger::Level::DEBUG) << "An AnimationComponent with ID(" + id + ") created." << std::endl;
+            return addAnimation( WorldEntities::EntityComponents::AnimationComponent( entitySprite ), clip, label, false );
+        }
+        
+        AnimationHandle AnimationManager::createAnimation( sf::VertexArray* vertexArray ,
+                                                           const int clip               ,
+                                                           const std::string& label )
+        {
+            if ( !vertexArray )
+            {
+                LOG(Logger::Level::ERROR) << "Invalid vertex array used to create a new AnimationComponent instance." << std::endl;
+                return AnimationHandle{};
+            }
             
-            return true;
+            return addAnimation( WorldEntities::EntityComponents::AnimationComponent( vertexArray ), clip, label, false );
         }
         
-        bool AnimationManager::createAnimation( const std::string& id        ,
-                                                sf::VertexArray* vertexArray ,
-                                                const sf::Vector2i frameSize ,
-                                                const unsigned maxFrame      ,
-                                                const sf::Time frameDuration )
+        AnimationHandle AnimationManager::createAnimation( const int clip               ,
+                                                           const std::string& label )
         {
-            if ( isStrWS( id ) )
+            return addAnimation( WorldEntities::EntityComponents::AnimationComponent(), clip, label, true );
+        }
+        
+        AnimationHandle AnimationManager::addAnimation( const WorldEntities::EntityComponents::AnimationComponent& component,
+                                                        const int clip,
+                                                        const std::string& label,
+                                                        const bool lazy )
+        {
+            if ( clip < 0 || clip >= static_cast<int>( m_clips.size() ) )
             {
-                LOG(Logger::Level::ERROR) << "Invalid ID used to create a new AnimationComponent instance." << std::endl;
-                return false;
+                LOG(Logger::Level::ERROR) << "Invalid animation clip used to create AnimationComponent(" << label << ")." << std::endl;
+                return AnimationHandle{};
             }
             
-            auto it = m_animations.find( id );
-            if ( it != m_animations.end() )
+            std::uint32_t slot;
+            
+            if ( !m_freeSlots.empty() )
             {
-                LOG(Logger::Level::ERROR) << "An AnimationComponent with ID(" + id + ") already exists." << std::endl;
-                return false;
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+            else
+            {
+                // Generations start at 1, a value initialized handle is never valid
+                slot = static_cast<std::uint32_t>( m_slots.size() );
+                m_slots.push_back( Slot{ 0, 1 } );
             }
             
-            m_animations[id] = std::make_shared<WorldEntities::EntityComponents::AnimationComponent>( vertexArray, frameSize, maxFrame, frameDuration );
-            LOG(Logger::Level::DEBUG) << "An AnimationComponent with ID(" + id + ") created." << std::endl;
-            return true;
+            m_slots[slot].m_index = static_cast<std::uint32_t>( m_components.size() );
+            
+            std::uint32_t group = static_cast<std::uint32_t>( clip );
+            
+            m_components.push_back( component );
+            m_groups.push_back( group );
+            m_visible.push_back( true );
+            m_lazy.push_back( lazy );
+            m_owners.push_back( slot );
+            m_labels.push_back( label );
+            m_shownFrames.push_back( groupFrame( group ) );
+            m_bounds.push_back( sf::FloatRect{} );
+            m_visits.push_back( 0 );
+            
+            if ( !lazy )
+                m_unbounded.push_back( slot );
+            
+            // Join the group at its current frame
+            m_components.back().setFrame( m_clips[clip].m_frames[m_shownFrames.back()] );
+            
+            LOG(Logger::Level::DEBUG) << "An AnimationComponent(" << label << ") created in slot " << slot << ", clip " << m_clips[clip].m_name << "." << std::endl;
+            
+            return AnimationHandle{ slot, m_slots[slot].m_generation };
         }
         
-        void AnimationManager::destroyAnimation( const std::string& id )
+        int AnimationManager::indexOf( const AnimationHandle handle )
         {
-            if ( isStrWS( id ) )
+            if ( handle.m_slot >= m_slots.size() || handle.m_generation != m_slots[handle.m_slot].m_generation )
+                return -1;
+            
+            return static_cast<int>( m_slots[handle.m_slot].m_index );
+        }
+        
+        void AnimationManager::destroyAnimation( const AnimationHandle handle )
+        {
+            int index = indexOf( handle );
+            if ( index < 0 )
             {
-                LOG(Logger::Level::ERROR) << "Invalid ID used to access an AnimationComponent instance." << std::endl;
+                LOG(Logger::Level::ERROR) << "Attempt to destroy an AnimationComponent that does not exist." << std::endl;
                 return;
             }
             
-            auto it = m_animations.find( id );
-            if ( it == m_animations.end() )
+            LOG(Logger::Level::DEBUG) << "Destroyed AnimationComponent(" << m_labels[index] << ")." << std::endl;
+            
+            if ( m_bounds[index].width > 0.f )
+                registerBounds( handle.m_slot, m_bounds[index], false );
+            else
+                m_unbounded.erase( std::remove( m_unbounded.begin(), m_unbounded.end(), handle.m_slot ), m_unbounded.end() );
+            
+            // Fill the hole with the last animation
+            std::size_t last = m_components.size() - 1;
+            
+            m_components[index] = m_components[last];
+            m_groups[index] = m_groups[last];
+            m_visible[index] = m_visible[last];
+            m_lazy[index] = m_lazy[last];
+            m_owners[index] = m_owners[last];
+            m_labels[index].swap( m_labels[last] );
+            m_shownFrames[index] = m_shownFrames[last];
+            m_bounds[index] = m_bounds[last];
+            m_visits[index] = m_visits[last];
+            
+            m_slots[m_owners[index]].m_index = static_cast<std::uint32_t>( index );
+            
+            m_components.pop_back();
+            m_groups.pop_back();
+            m_visible.pop_back();
+            m_lazy.pop_back();
+            m_owners.pop_back();
+            m_labels.pop_back();
+            m_shownFrames.pop_back();
+            m_bounds.pop_back();
+            m_visits.pop_back();
+            
+            // Invalidate the handles to the slot
+            Slot& slot = m_slots[handle.m_slot];
+            if ( ++slot.m_generation == 0 )
+                slot.m_generation = 1;
+            
+            m_freeSlots.push_back( handle.m_slot );
+        }
+        
+        void AnimationManager::syncAnimations( const std::vector<AnimationHandle>& animations )
+        {
+            for ( auto&& handle : animations )
             {
-                LOG(Logger::Level::ERROR) << "An AnimationComponent with ID(" + id + ") does not exist." << std::endl;
+                int index = indexOf( handle );
+                if ( index < 0 )
+                {
+                    LOG(Logger::Level::ERROR) << "Attempt to sync an AnimationComponent that does not exist." << std::endl;
+                    continue;
+                }
+                
+                m_groupStarts[m_groups[index]] = m_now;
+            }
+            
+            refreshFrames();
+        }
+        
+        void AnimationManager::setVisibility( const AnimationHandle handle, bool visibility )
+        {
+            int index = indexOf( handle );
+            if ( index < 0 )
+            {
+                LOG(Logger::Level::ERROR) << "Attempt to access an AnimationComponent that does not exist." << std::endl;
                 return;
             }
             
-            m_animations.erase( it );
+            m_visible[index] = visibility;
+        }
+        
+        void AnimationManager::setBounds( const AnimationHandle handle, const sf::FloatRect& bounds )
+        {
+            int index = indexOf( handle );
+            if ( index < 0 )
+            {
+                LOG(Logger::Level::ERROR) << "Attempt to access an AnimationComponent that does not exist." << std::endl;
+                return;
+            }
+            
+            // Lazy animations are never updated, wherever they are
+            if ( m_lazy[index] )
+                return;
+            
+            if ( m_bounds[index].width > 0.f )
+                registerBounds( handle.m_slot, m_bounds[index], false );
+            else
+                m_unbounded.erase( std::remove( m_unbounded.begin(), m_unbounded.end(), handle.m_slot ), m_unbounded.end() );
+            
+            m_bounds[index] = bounds;
             
-            LOG(Logger::Level::DEBUG) << "Destroyed AnimationComponent with ID: " + id + "." << std::endl;
+            if ( bounds.width > 0.f )
+                registerBounds( handle.m_slot, bounds, true );
+            else
+                m_unbounded.push_back( handle.m_slot );
         }
         
-        void AnimationManager::syncAnimations( const std::vector<std::string>& IDs )
+        void AnimationManager::setViewRect( const sf::FloatRect& viewRect )
         {
-            for ( auto&& id : IDs )
+            m_viewRect = viewRect;
+            m_culling = true;
+        }
+        
+        void AnimationManager::resetViewRect()
+        {
+            m_culling = false;
+        }
+        
+        void AnimationManager::registerBounds( const std::uint32_t slot, const sf::FloatRect& bounds, const bool add )
+        {
+            int x0 = static_cast<int>( std::floor( bounds.left / CELL_SIZE ) );
+            int y0 = static_cast<int>( std::floor( bounds.top / CELL_SIZE ) );
+            int x1 = static_cast<int>( std::floor( ( bounds.left + bounds.width ) / CELL_SIZE ) );
+            int y1 = static_cast<int>( std::floor( ( bounds.top + bounds.height ) / CELL_SIZE ) );
+            
+            for ( int y = y0; y <= y1; ++y )
             {
-                if ( exists( id ) )
+                for ( int x = x0; x <= x1; ++x )
                 {
+                    if ( add )
+                    {
+                        m_cells[std::make_pair( y, x )].push_back( slot );
+                        continue;
+                    }
+                    
+                    auto it = m_cells.find( std::make_pair( y, x ) );
+                    if ( it == m_cells.end() )
+                        continue;
                     
+                    it->second.erase( std::remove( it->second.begin(), it->second.end(), slot ), it->second.end() );
+                    if ( it->second.empty() )
+                        m_cells.erase( it );
                 }
-                else
-                    LOG(Logger::Level::ERROR) << "An AnimationComponent with ID(" + id + ") does not exist." << std::endl;
             }
         }
         
-        void AnimationManager::setVisibility( const std::string& id, bool visibility )
+        int AnimationManager::getFrame( const AnimationHandle handle )
         {
-            if ( isStrWS( id ) )
+            int index = indexOf( handle );
+            if ( index < 0 )
             {
-                LOG(Logger::Level::ERROR) << "Invalid ID used to access an AnimationComponent instance." << std::endl;
-                return;
+                LOG(Logger::Level::ERROR) << "Attempt to access an AnimationComponent that does not exist." << std::endl;
+                return 0;
             }
             
-            auto it = m_animations.find( id );
-            if ( it == m_animations.end() )
+            return groupFrame( m_groups[index] );
+        }
+        
+        sf::IntRect AnimationManager::getFrameRect( const AnimationHandle handle )
+        {
+            int index = indexOf( handle );
+            if ( index < 0 )
             {
-                LOG(Logger::Level::ERROR) << "An AnimationComponent with ID(" + id + ") does not exist." << std::endl;
-                return;
+                LOG(Logger::Level::ERROR) << "Attempt to access an AnimationComponent that does not exist." << std::endl;
+                return sf::IntRect{};
             }
             
-            //std::cout << "ZZZZZZZZZZZZZ" << std::endl;
-            it->second->m_visible = visibility;
+            std::uint32_t group = m_groups[index];
+            return m_clips[group].m_frames[groupFrame( group )];
         }
         
-        void AnimationManager::update( const sf::Event& event,
-                     const sf::Vector2i mousePos,
-                     const sf::Time dt )
+        sf::Time AnimationManager::getTime()
+        {
+            return m_now;
+        }
+        
+        void AnimationManager::setTime( const sf::Time now )
         {
-            for ( auto&& anim : m_animations )
+            m_now = now;
+            refreshFrames();
+        }
+        
+        int AnimationManager::groupFrame( const std::uint32_t group )
+        {
+            const AnimationClip& clip = m_clips[group];
+            
+            sf::Int64 length = clip.m_frameEnds.back().asMicroseconds();
+            sf::Int64 elapsed = ( m_now - m_groupStarts[group] ).asMicroseconds();
+            
+            // The clock may have been set to before the group started
+            if ( clip.m_loop )
+                elapsed = ( elapsed % length + length ) % length;
+            else
+                elapsed = std::max<sf::Int64>( 0, std::min( elapsed, length - 1 ) );
+            
+            // The first frame ending after the elapsed time
+            auto it = std::upper_bound( clip.m_frameEnds.begin(), clip.m_frameEnds.end(), sf::microseconds( elapsed ) );
+            
+            return static_cast<int>( it - clip.m_frameEnds.begin() );
+        }
+        
+        void AnimationManager::refreshFrames()
+        {
+            for ( std::size_t g = 0; g < m_clips.size(); ++g )
+                m_groupFrames[g] = groupFrame( static_cast<std::uint32_t>( g ) );
+            
+            if ( !m_culling )
             {
-                if ( anim.second->m_type == WorldEntities::EntityComponents::AnimationComponent::SpriteType::NONE )
-                    continue;
+                ThreadPool::getInstance().parallelFor( m_components.size(), UPDATE_GRAIN, []( std::size_t begin, std::size_t end )
+                {
+                    for ( std::size_t i = begin; i < end; ++i )
+                        showFrame( i );
+                } );
                 
-                if ( !anim.second->m_visible )
-                    continue;
+                return;
+            }
             
-                // The duration fo one frame of the animation
-                sf::Time frameTime = anim.second->m_duration / float(anim.second->m_maxFrame);
-                
-                // Time elapsed since last frame change
-                anim.second->m_elapsedTime += dt;
+            // Gather the animations in view, then show their frames
+            m_pending.clear();
+            
+            for ( auto&& slot : m_unbounded )
+                m_pending.push_back( m_slots[slot].m_index );
+            
+            // Visit the animations in the cells under the view
+            ++m_updates;
+            
+            int x0 = static_cast<int>( std::floor( m_viewRect.left / CELL_SIZE ) );
+            int y0 = static_cast<int>( std::floor( m_viewRect.top / CELL_SIZE ) );
+            int x1 = static_cast<int>( std::floor( ( m_viewRect.left + m_viewRect.width ) / CELL_SIZE ) );
+            int y1 = static_cast<int>( std::floor( ( m_viewRect.top + m_viewRect.height ) / CELL_SIZE ) );
+            
+            for ( int y = y0; y <= y1; ++y )
+            {
+                auto end = m_cells.upper_bound( std::make_pair( y, x1 ) );
                 
-                // If the elpased time since last frame change is greater than
-                // or equal to the time per animation frame, we update the frame
-                if ( anim.second->m_elapsedTime >= frameTime )
+                for ( auto it = m_cells.lower_bound( std::make_pair( y, x0 ) ); it != end; ++it )
                 {
-                    // Update the current frame to the next frame
-                    anim.second->m_currentFrame = ( anim.second->m_currentFrame + 1 ) % ( anim.second->m_maxFrame + 1 );
-                    
-                    // Update the texture rects for the sprite, according to its type, i.e., sf::Sprite or sf::VertexArray                    
-                    if ( anim.second->m_type == WorldEntities::EntityComponents::AnimationComponent::SpriteType::SF_SPRITE )
+                    for ( auto&& slot : it->second )
                     {
-                        anim.second->m_textureRect = sf::IntRect{ anim.second->m_frameSize.x * anim.second->m_currentFrame,
-                                                                  0,
-                                                                  anim.second->m_frameSize.x,
-                                                                  anim.second->m_frameSize.y };
-                                                              
-                        anim.second->m_entitySprite.m_spritePtr->setTextureRect( anim.second->m_textureRect );
+                        std::uint32_t index = m_slots[slot].m_index;
+                        
+                        if ( m_visits[index] == m_updates )
+                            continue;
+                        
+                        m_visits[index] = m_updates;
+                        
+                        if ( m_bounds[index].intersects( m_viewRect ) )
+                            m_pending.push_back( index );
                     }
-                    else
-                    {
-                        if ( anim.second->m_currentFrame == 0 )
-                        {   
-                            (*anim.second->m_entitySprite.m_vertexArrayPtr)[0].texCoords.x = anim.second->m_frameSize.x / 2;
-                            (*anim.second->m_entitySprite.m_vertexArrayPtr)[1].texCoords.x = anim.second->m_frameSize.x;
-                            (*anim.second->m_entitySprite.m_vertexArrayPtr)[2].texCoords.x = anim.second->m_frameSize.x / 2;
-                            (*anim.second->m_entitySprite.m_vertexArrayPtr)[3].texCoords.x = 0;
-                        }
-                        else
-                        {
-                            (*anim.second->m_entitySprite.m_vertexArrayPtr)[0].texCoords.x += anim.second->m_frameSize.x;
-                            (*anim.second->m_entitySprite.m_vertexArrayPtr)[1].texCoords.x += anim.second->m_frameSize.x;
-                            (*anim.second->m_entitySprite.m_vertexArrayPtr)[2].texCoords.x += anim.second->m_frameSize.x;
-                            (*anim.second->m_entitySprite.m_vertexArrayPtr)[3].texCoords.x += anim.second->m_frameSize.x;
-                        }
-                    }
-                    
-                    anim.second->m_elapsedTime -= frameTime;
                 }
             }
+            
+            ThreadPool::getInstance().parallelFor( m_pending.size(), UPDATE_GRAIN, []( std::size_t begin, std::size_t end )
+            {
+                for ( std::size_t i = begin; i < end; ++i )
+                    showFrame( m_pending[i] );
+            } );
+        }
+        
+        void AnimationManager::showFrame( const std::size_t index )
+        {
+            if ( !m_visible[index] || m_lazy[index] )
+                return;
+            
+            int frame = m_groupFrames[m_groups[index]];
+            if ( m_shownFrames[index] == frame )
+                return;
+            
+            // Update the texture rects for the sprite, according to its type, i.e., sf::Sprite or sf::VertexArray.
+            // Every animation has a sprite of its own, so this may run on any thread.
+            m_components[index].setFrame( m_clips[m_groups[index]].m_frames[frame] );
+            m_shownFrames[index] = frame;
+        }
+        
+        void AnimationManager::update( const sf::Event& event,
+                     const sf::Vector2i mousePos,
+                     const sf::Time dt )
+        {
+            m_now += dt;
+            refreshFrames();
         }
     }
 }
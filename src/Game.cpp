@@ -13,982 +13,90 @@
  *  in Game module.
  */
 
-#include <SFML/Window/Mouse.hpp>
-
-#include "Utility/Constants.hpp"
-#include "Utility/Log.hpp"
-#include "ResourceManager/ResourceManager.hpp"
-#include "ComponentManager/ComponentManager.hpp"
-#include "GameStates/MainMenuState.hpp"
-#include "GameStates/MapEditorState.hpp"
-#include "Game.hpp"
-
-namespace rts
-{
-    Game::Game()
-    {
-        sf::ContextSettings settings;
-        settings.depthBits = 24;
-        settings.stencilBits = 8;
-        settings.antialiasingLevel = 1;
-        settings.majorVersion = 3;
-        settings.minorVersion = 0;
-        
-        // Create a new game window with the default dimensions
-        // and title as set in the Utility::Constants module.
-        m_window.create( sf::VideoMode( WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_BPP ),
-                         WINDOW_TITLE,
-                         sf::Style::Fullscreen,
-                         settings );
-        
-        m_window.setMouseCursorVisible(false);
-        
-        LOG(Logger::Level::DEBUG) << "Creating Game object." << std::endl;
-        
-        // Limit the game frame rate as set in Utility::Constants module.
-        m_window.setFramerateLimit( FRAMES_PER_SECOND );
-        
-        m_active = true;
-        
-                
-        /* Import all game assets by invoking the apporiate methods of the resource manager module.
-         * 
-         * 1. First the textures are imported.
-         * 2. Next the fonts are imported.
-         */
-        
-        bool allResLoaded = true;
-        
-        if ( !ResourceManager::addTexture( TextureID::MOUSE_POINTER, PATH_TEXTURES + TEXTURE_MOUSE_POINTER ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add mouse pointer texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::DEFAULT_BACKGROUND, PATH_TEXTURES + TEXTURE_DEFAULT_BACKGROUND ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add background texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::MAIN_MENU_BACKGROUND, PATH_TEXTURES + TEXTURE_MAIN_MENU_BACKGROUND) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add main menu background texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::MAP_EDITOR_BACKGROUND, PATH_TEXTURES + TEXTURE_MAP_EDITOR_BACKGROUND) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add main menu background texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_DEFAULT_BUTTON, PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_BUTTON ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add UI button texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_MENU_BUTTON, PATH_UI_TEXTURES + TEXTURE_UI_MENU_BUTTON ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add UI menu button texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_DEFAULT_PICTURE, PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_PICTURE ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add default UI picture texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_DEFAULT_RADIOBUTTON_NORMAL, PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_RADIOBUTTON_NORMAL ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add UI radio button normal texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_DEFAULT_LISTITEM, PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_LISTITEM ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add UI list item texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_DEFAULT_COMBOBOX_SELECTED, PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_COMBOBOX_SELECTED ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add UI combo box texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_DEFAULT_COMBOBOX_ARROW, PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_COMBOBOX_ARROW ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add UI combo box arrow texture resource." << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_TILEBOX, PATH_UI_TEXTURES + TEXTURE_UI_TILEBOX ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::UI_TILEBOX ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_SCROLL_AREA, PATH_UI_TEXTURES + TEXTURE_UI_SCROLL_AREA ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::UI_SCROLL_AREA) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_SCROLL_BAR, PATH_UI_TEXTURES + TEXTURE_UI_SCROLL_BAR ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::UI_SCROLL_BAR ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_SCROLL_ARROW_UP, PATH_UI_TEXTURES + TEXTURE_UI_SCROLL_ARROW_UP ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::UI_SCROLL_ARROW_UP) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::UI_SCROLL_ARROW_DOWN, PATH_UI_TEXTURES + TEXTURE_UI_SCROLL_ARROW_DOWN ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::UI_SCROLL_ARROW_DOWN ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_WATER_01, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_WATER_01 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_WATER_01 ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_0000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0000 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_0000 ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_0001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0001 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_0001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_0010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0010 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_0010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_0011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0011 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_0011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_0100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0100 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_0100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_0101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0101 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_0101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_0110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0110 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_0110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_0111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0111 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_0111 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_1000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1000 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_1000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_1001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1001 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_1001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_1010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1010 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_1010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_1011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1011 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_1011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_1100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1100 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_1100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_1101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1101 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_1101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_1110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1110 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_1110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_0_1111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1111 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_0_1111 ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_0000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0000 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_0000 ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_0001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0001 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_0001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_0010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0010 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_0010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_0011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0011 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_0011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_0100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0100 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_0100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_0101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0101 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_0101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_0110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0110 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_0110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_0111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0111 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_0111 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_1000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1000 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_1000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_1001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1001 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_1001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_1010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1010 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_1010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_1011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1011 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_1011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_1100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1100 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_1100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_1101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1101 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_1101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_1110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1110 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_1110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_1_1111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1111 ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_1_1111 ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        // Desert tile textures
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_0000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0000 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_0000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_0001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0001 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_0001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_0010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0010 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_0010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_0011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0011 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_0011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_0100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0100 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_0100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_0101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0101 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_0101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_0110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0110 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_0110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_0111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0111 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_0111 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_1000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1000 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_1000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_1001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1001 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_1001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_1010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1010 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_1010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_1011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1011 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_1011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_1100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1100 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_1100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_1101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1101 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_1101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_1110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1110 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_1110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_0_1111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1111 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_0_1111 ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_0000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0000 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_0000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_0001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0001 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_0001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_0010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0010 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_0010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_0011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0011 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_0011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_0100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0100 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_0100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_0101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0101 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_0101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_0110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0110 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_0110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_0111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0111 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_0111 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_1000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1000 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_1000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_1001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1001 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_1001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_1010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1010 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_1010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_1011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1011 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_1011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_1100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1100 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_1100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_1101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1101 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_1101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_1110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1110 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_1110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_1_1111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1111 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_1_1111 ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        // Snow terrain
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_0000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0000 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_0000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_0001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0001 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_0001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_0010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0010 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_0010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_0011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0011 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_0011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_0100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0100 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_0100 ) << std::endl;
-            allResLoaded = false;
-        }
+#include <algorithm>
+#include <thread>
 
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_0101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0101 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_0101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_0110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0110 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_0110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_0111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0111 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_0111 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_1000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1000 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_1000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_1001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1001 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_1001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_1010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1010 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_1010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_1011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1011 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_1011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_1100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1100 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_1100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_1101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1101 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_1101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_1110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1110 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_1110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_0_1111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1111 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_0_1111 ) << std::endl;
-            allResLoaded = false;
-        }
-        
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_0000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0000 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_0000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_0001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0001 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_0001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_0010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0010 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_0010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_0011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0011 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_0011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_0100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0100 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_0100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_0101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0101 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_0101 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_0110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0110 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_0110 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_0111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0111 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_0111 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_1000, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1000 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_1000 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_1001, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1001 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_1001 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_1010, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1010 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_1010 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_1011, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1011 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_1011 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_1100, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1100 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_1100 ) << std::endl;
-            allResLoaded = false;
-        }
-
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_1101, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1101 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_1101 ) << std::endl;
-            allResLoaded = false;
-        }
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/Window/Mouse.hpp>
 
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_1110, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1110 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_1110 ) << std::endl;
-            allResLoaded = false;
-        }
+#include "Utility/Constants.hpp"
+#include "Utility/Log.hpp"
+#include "ResourceManager/ResourceManager.hpp"
+#include "AnimationManager/AnimationManager.hpp"
+#include "ComponentManager/ComponentManager.hpp"
+#include "GameStates/LoadingState.hpp"
+#include "GameStates/MainMenuState.hpp"
+#include "GameStates/MapEditorState.hpp"
+#include "Game.hpp"
 
-        if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_SNOW_1_1111, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1111 ) )
-        { 
-            LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_SNOW_1_1111 ) << std::endl;
-            allResLoaded = false;
-        }
-        
+namespace rts
+{
+    Game::Game()
+    {
+        sf::ContextSettings settings;
+        settings.depthBits = 24;
+        settings.stencilBits = 8;
+        settings.antialiasingLevel = 1;
+        settings.majorVersion = 3;
+        settings.minorVersion = 0;
         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_DESERT_01, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_01) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_DESERT_01 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_WATER_01, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_WATER_01 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_WATER_01 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_01, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_01 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_01 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_01, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_01 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_01 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_02, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_02 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_02 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_012, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_012 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_012 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_013, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_013 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_013 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_112, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_112 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_112 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_113, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_113 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_113 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_114, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_114 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_114 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_01432, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_01432 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_01432 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_11432, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_11432 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_11432 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_132, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_132 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_132 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_134, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_134 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_134 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_03, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_03 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_03 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_GRASS_DESERT_04, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_04 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_GRASS_DESERT_04 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_01, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_01 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_01 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_014, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_014 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_014 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_02, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_02 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_02 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_023, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_023 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_023 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_03, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_03 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_03 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_032, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_032 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_032 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_04, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_04 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_04 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_013, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_013 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_013 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_113, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_113 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_113 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_123, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_123 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_123 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_0013, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_0013 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_0013 ) << std::endl;
-//             allResLoaded = false;
-//         }
-//         
-//         if ( !ResourceManager::addTexture( TextureID::TERRAIN_TILE_BEACH_1113, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_1113 ) )
-//         {
-//             LOG(Logger::Level::DEBUG) << "Unable to add texture resource: " << textureIDToStr( TextureID::TERRAIN_TILE_BEACH_1113 ) << std::endl;
-//             allResLoaded = false;
-//         }
+        // Create a new game window with the default dimensions
+        // and title as set in the Utility::Constants module.
+        m_window.create( sf::VideoMode( WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_BPP ),
+                         WINDOW_TITLE,
+                         sf::Style::Fullscreen,
+                         settings );
         
-        // Load all fonts
+        m_window.setMouseCursorVisible(false);
         
-        if ( !ResourceManager::addFont( FontID::DEFAULT, PATH_FONTS + FONT_DEFAULT ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add default font resource." << std::endl;
-            allResLoaded = false;
-        }
+        LOG(Logger::Level::DEBUG) << "Creating Game object." << std::endl;
         
-        if ( !ResourceManager::addFont( FontID::BASKERVILLE_OLD_FACE_REGULAR, PATH_FONTS + FONT_BASKERVILLE_OLD_FACE_REGULAR ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::BASKERVILLE_OLD_FACE_REGULAR ) << std::endl;
-            allResLoaded = false;
-        }
+        // Limit the game frame rate as set in Utility::Constants module.
+        m_window.setFramerateLimit( FRAMES_PER_SECOND );
         
-        if ( !ResourceManager::addFont( FontID::BEYOND_WONDERLAND, PATH_FONTS + FONT_BEYOND_WONDERLAND ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::BEYOND_WONDERLAND ) << std::endl;
-            allResLoaded = false;
-        }
+        m_active = true;
+        m_simulating = false;
+        m_lastStep = 0;
         
-        if ( !ResourceManager::addFont( FontID::BOOK_ANTIQUA_BOLD, PATH_FONTS + FONT_BOOK_ANTIQUA_BOLD ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::BOOK_ANTIQUA_BOLD ) << std::endl;
-            allResLoaded = false;
-        }
+                
+        /* Import the game assets by invoking the apporiate methods of the resource manager module.
+         * 
+         * 1. First the assets of the main menu are imported, see getAssetSet().
+         * 2. Next the assets of the other states are requested in the background.
+         */
         
-        if ( !ResourceManager::addFont( FontID::CLOISTER_BLACK_LIGHT, PATH_FONTS + FONT_CLOISTER_BLACK_LIGHT ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::CLOISTER_BLACK_LIGHT ) << std::endl;
-            allResLoaded = false;
-        }
+        bool allResLoaded = true;
         
-        if ( !ResourceManager::addFont( FontID::CONSTANTIA_REGULAR, PATH_FONTS + FONT_CONSTANTIA_REGULAR ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::CONSTANTIA_REGULAR ) << std::endl;
-            allResLoaded = false;
-        }
+        sf::Clock startupClock;
         
-        if ( !ResourceManager::addFont( FontID::DEJAVU_SERIF_BOOK, PATH_FONTS + FONT_DEJAVU_SERIF_BOOK ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::DEJAVU_SERIF_BOOK ) << std::endl;
-            allResLoaded = false;
-        }
+        if ( !ResourceManager::openArchive( PATH_ASSETS + ASSET_ARCHIVE ) )
+            LOG(Logger::Level::INFO) << "No asset archive found, loading the assets from their files." << std::endl;
         
-        if ( !ResourceManager::addFont( FontID::GARAMOND_BOLD, PATH_FONTS + FONT_GARAMOND_BOLD ) )
+        // Load only what the main menu needs up front, the
+        // assets of the other states stream in behind it
+        if ( !ResourceManager::loadAssetSet( getAssetSet( State::MAIN_MENU ) ) )
         {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::GARAMOND_BOLD ) << std::endl;
+            LOG(Logger::Level::DEBUG) << "Unable to add all the main menu resources." << std::endl;
             allResLoaded = false;
         }
         
-        if ( !ResourceManager::addFont( FontID::MONACO, PATH_FONTS + FONT_MONACO ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::MONACO ) << std::endl;
-            allResLoaded = false;
-        }
+        // The game itself draws textures of the main menu set, e.g., the mouse pointer
+        ResourceManager::pinAssetSet( getAssetSet( State::MAIN_MENU ) );
         
-        if ( !ResourceManager::addFont( FontID::OLD_SERIF_GUT_REGULAR, PATH_FONTS + FONT_OLD_SERIF_GUT_REGULAR ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::OLD_SERIF_GUT_REGULAR ) << std::endl;
-            allResLoaded = false;
-        }
+        sf::Time menuTime = startupClock.getElapsedTime();
         
-        if ( !ResourceManager::addFont( FontID::RINGBEARER_MEDIUM, PATH_FONTS + FONT_RINGBEARER_MEDIUM ) )
+        if ( !AnimationManager::AnimationManager::loadClips( PATH_ANIMATIONS + ANIMATION_CLIPS ) )
         {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::RINGBEARER_MEDIUM ) << std::endl;
+            LOG(Logger::Level::DEBUG) << "Unable to load animation clips: " << PATH_ANIMATIONS + ANIMATION_CLIPS << std::endl;
             allResLoaded = false;
         }
         
-        if ( !ResourceManager::addFont( FontID::ROBOTO_BOLD, PATH_FONTS + FONT_ROBOTO_BOLD ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::ROBOTO_BOLD ) << std::endl;
-            allResLoaded = false;
-        }
+        ResourceManager::requestAssetSet( getAssetSet( State::MAP_EDITOR ) );
+        ResourceManager::requestAssetSet( getAssetSet( State::PLAYING ) );
         
-        if ( !ResourceManager::addFont( FontID::SOURCE_HAN_SANS_CN_NORMAL, PATH_FONTS + FONT_SOURCE_HAN_SANS_CN_NORMAL ) )
-        {
-            LOG(Logger::Level::DEBUG) << "Unable to add font resource: " << fontIDToStr( FontID::SOURCE_HAN_SANS_CN_NORMAL ) << std::endl;
-            allResLoaded = false;
-        }
+        LOG(Logger::Level::INFO) << "Startup took " << startupClock.getElapsedTime().asMilliseconds() << " ms, of which "
+                                 << menuTime.asMilliseconds() << " ms loading the main menu assets." << std::endl;
         
         if ( allResLoaded )
         {
@@ -1013,6 +121,226 @@ namespace rts
         }
     }
     
+    const ResourceManager::AssetSet& Game::getAssetSet( const State state )
+    {
+        // The main menu & the UI shared by all states
+        static const ResourceManager::AssetSet mainMenuSet =
+        {
+            {
+                { TextureID::MOUSE_POINTER,                   PATH_TEXTURES + TEXTURE_MOUSE_POINTER },
+                { TextureID::DEFAULT_BACKGROUND,              PATH_TEXTURES + TEXTURE_DEFAULT_BACKGROUND },
+                { TextureID::MAIN_MENU_BACKGROUND,            PATH_TEXTURES + TEXTURE_MAIN_MENU_BACKGROUND },
+                { TextureID::UI_DEFAULT_BUTTON,               PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_BUTTON },
+                { TextureID::UI_MENU_BUTTON,                  PATH_UI_TEXTURES + TEXTURE_UI_MENU_BUTTON },
+                { TextureID::UI_DEFAULT_PICTURE,              PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_PICTURE },
+                { TextureID::UI_DEFAULT_RADIOBUTTON_NORMAL,   PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_RADIOBUTTON_NORMAL },
+                { TextureID::UI_DEFAULT_LISTITEM,             PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_LISTITEM },
+                { TextureID::UI_DEFAULT_COMBOBOX_SELECTED,    PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_COMBOBOX_SELECTED },
+                { TextureID::UI_DEFAULT_COMBOBOX_ARROW,       PATH_UI_TEXTURES + TEXTURE_UI_DEFAULT_COMBOBOX_ARROW },
+                { TextureID::UI_TILEBOX,                      PATH_UI_TEXTURES + TEXTURE_UI_TILEBOX },
+                { TextureID::UI_SCROLL_AREA,                  PATH_UI_TEXTURES + TEXTURE_UI_SCROLL_AREA },
+                { TextureID::UI_SCROLL_BAR,                   PATH_UI_TEXTURES + TEXTURE_UI_SCROLL_BAR },
+                { TextureID::UI_SCROLL_ARROW_UP,              PATH_UI_TEXTURES + TEXTURE_UI_SCROLL_ARROW_UP },
+                { TextureID::UI_SCROLL_ARROW_DOWN,            PATH_UI_TEXTURES + TEXTURE_UI_SCROLL_ARROW_DOWN }
+            },
+            {
+                { FontID::DEFAULT,                      PATH_FONTS + FONT_DEFAULT },
+                { FontID::BASKERVILLE_OLD_FACE_REGULAR, PATH_FONTS + FONT_BASKERVILLE_OLD_FACE_REGULAR },
+                { FontID::BEYOND_WONDERLAND,            PATH_FONTS + FONT_BEYOND_WONDERLAND },
+                { FontID::BOOK_ANTIQUA_BOLD,            PATH_FONTS + FONT_BOOK_ANTIQUA_BOLD },
+                { FontID::CLOISTER_BLACK_LIGHT,         PATH_FONTS + FONT_CLOISTER_BLACK_LIGHT },
+                { FontID::CONSTANTIA_REGULAR,           PATH_FONTS + FONT_CONSTANTIA_REGULAR },
+                { FontID::DEJAVU_SERIF_BOOK,            PATH_FONTS + FONT_DEJAVU_SERIF_BOOK },
+                { FontID::GARAMOND_BOLD,                PATH_FONTS + FONT_GARAMOND_BOLD },
+                { FontID::MONACO,                       PATH_FONTS + FONT_MONACO },
+                { FontID::OLD_SERIF_GUT_REGULAR,        PATH_FONTS + FONT_OLD_SERIF_GUT_REGULAR },
+                { FontID::RINGBEARER_MEDIUM,            PATH_FONTS + FONT_RINGBEARER_MEDIUM },
+                { FontID::ROBOTO_BOLD,                  PATH_FONTS + FONT_ROBOTO_BOLD },
+                { FontID::SOURCE_HAN_SANS_CN_NORMAL,    PATH_FONTS + FONT_SOURCE_HAN_SANS_CN_NORMAL }
+            }
+        };
+        
+        // The terrain of the map
+        static const ResourceManager::AssetSet mapSet =
+        {
+            {
+                { TextureID::MAP_EDITOR_BACKGROUND,           PATH_TEXTURES + TEXTURE_MAP_EDITOR_BACKGROUND },
+                { TextureID::TERRAIN_TILE_WATER_01,           PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_WATER_01 },
+                { TextureID::TERRAIN_TILE_GRASS_0_0000,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0000 },
+                { TextureID::TERRAIN_TILE_GRASS_0_0001,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0001 },
+                { TextureID::TERRAIN_TILE_GRASS_0_0010,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0010 },
+                { TextureID::TERRAIN_TILE_GRASS_0_0011,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0011 },
+                { TextureID::TERRAIN_TILE_GRASS_0_0100,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0100 },
+                { TextureID::TERRAIN_TILE_GRASS_0_0101,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0101 },
+                { TextureID::TERRAIN_TILE_GRASS_0_0110,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0110 },
+                { TextureID::TERRAIN_TILE_GRASS_0_0111,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_0111 },
+                { TextureID::TERRAIN_TILE_GRASS_0_1000,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1000 },
+                { TextureID::TERRAIN_TILE_GRASS_0_1001,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1001 },
+                { TextureID::TERRAIN_TILE_GRASS_0_1010,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1010 },
+                { TextureID::TERRAIN_TILE_GRASS_0_1011,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1011 },
+                { TextureID::TERRAIN_TILE_GRASS_0_1100,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1100 },
+                { TextureID::TERRAIN_TILE_GRASS_0_1101,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1101 },
+                { TextureID::TERRAIN_TILE_GRASS_0_1110,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1110 },
+                { TextureID::TERRAIN_TILE_GRASS_0_1111,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_0_1111 },
+                { TextureID::TERRAIN_TILE_GRASS_1_0000,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0000 },
+                { TextureID::TERRAIN_TILE_GRASS_1_0001,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0001 },
+                { TextureID::TERRAIN_TILE_GRASS_1_0010,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0010 },
+                { TextureID::TERRAIN_TILE_GRASS_1_0011,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0011 },
+                { TextureID::TERRAIN_TILE_GRASS_1_0100,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0100 },
+                { TextureID::TERRAIN_TILE_GRASS_1_0101,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0101 },
+                { TextureID::TERRAIN_TILE_GRASS_1_0110,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0110 },
+                { TextureID::TERRAIN_TILE_GRASS_1_0111,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_0111 },
+                { TextureID::TERRAIN_TILE_GRASS_1_1000,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1000 },
+                { TextureID::TERRAIN_TILE_GRASS_1_1001,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1001 },
+                { TextureID::TERRAIN_TILE_GRASS_1_1010,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1010 },
+                { TextureID::TERRAIN_TILE_GRASS_1_1011,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1011 },
+                { TextureID::TERRAIN_TILE_GRASS_1_1100,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1100 },
+                { TextureID::TERRAIN_TILE_GRASS_1_1101,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1101 },
+                { TextureID::TERRAIN_TILE_GRASS_1_1110,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1110 },
+                { TextureID::TERRAIN_TILE_GRASS_1_1111,       PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_1_1111 },
+                
+                // Desert tile textures
+                { TextureID::TERRAIN_TILE_DESERT_0_0000,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0000 },
+                { TextureID::TERRAIN_TILE_DESERT_0_0001,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0001 },
+                { TextureID::TERRAIN_TILE_DESERT_0_0010,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0010 },
+                { TextureID::TERRAIN_TILE_DESERT_0_0011,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0011 },
+                { TextureID::TERRAIN_TILE_DESERT_0_0100,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0100 },
+                { TextureID::TERRAIN_TILE_DESERT_0_0101,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0101 },
+                { TextureID::TERRAIN_TILE_DESERT_0_0110,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0110 },
+                { TextureID::TERRAIN_TILE_DESERT_0_0111,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_0111 },
+                { TextureID::TERRAIN_TILE_DESERT_0_1000,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1000 },
+                { TextureID::TERRAIN_TILE_DESERT_0_1001,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1001 },
+                { TextureID::TERRAIN_TILE_DESERT_0_1010,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1010 },
+                { TextureID::TERRAIN_TILE_DESERT_0_1011,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1011 },
+                { TextureID::TERRAIN_TILE_DESERT_0_1100,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1100 },
+                { TextureID::TERRAIN_TILE_DESERT_0_1101,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1101 },
+                { TextureID::TERRAIN_TILE_DESERT_0_1110,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1110 },
+                { TextureID::TERRAIN_TILE_DESERT_0_1111,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_0_1111 },
+                { TextureID::TERRAIN_TILE_DESERT_1_0000,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0000 },
+                { TextureID::TERRAIN_TILE_DESERT_1_0001,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0001 },
+                { TextureID::TERRAIN_TILE_DESERT_1_0010,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0010 },
+                { TextureID::TERRAIN_TILE_DESERT_1_0011,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0011 },
+                { TextureID::TERRAIN_TILE_DESERT_1_0100,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0100 },
+                { TextureID::TERRAIN_TILE_DESERT_1_0101,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0101 },
+                { TextureID::TERRAIN_TILE_DESERT_1_0110,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0110 },
+                { TextureID::TERRAIN_TILE_DESERT_1_0111,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_0111 },
+                { TextureID::TERRAIN_TILE_DESERT_1_1000,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1000 },
+                { TextureID::TERRAIN_TILE_DESERT_1_1001,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1001 },
+                { TextureID::TERRAIN_TILE_DESERT_1_1010,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1010 },
+                { TextureID::TERRAIN_TILE_DESERT_1_1011,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1011 },
+                { TextureID::TERRAIN_TILE_DESERT_1_1100,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1100 },
+                { TextureID::TERRAIN_TILE_DESERT_1_1101,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1101 },
+                { TextureID::TERRAIN_TILE_DESERT_1_1110,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1110 },
+                { TextureID::TERRAIN_TILE_DESERT_1_1111,      PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_1_1111 },
+                
+                // Snow terrain
+                { TextureID::TERRAIN_TILE_SNOW_0_0000,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0000 },
+                { TextureID::TERRAIN_TILE_SNOW_0_0001,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0001 },
+                { TextureID::TERRAIN_TILE_SNOW_0_0010,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0010 },
+                { TextureID::TERRAIN_TILE_SNOW_0_0011,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0011 },
+                { TextureID::TERRAIN_TILE_SNOW_0_0100,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0100 },
+                { TextureID::TERRAIN_TILE_SNOW_0_0101,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0101 },
+                { TextureID::TERRAIN_TILE_SNOW_0_0110,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0110 },
+                { TextureID::TERRAIN_TILE_SNOW_0_0111,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_0111 },
+                { TextureID::TERRAIN_TILE_SNOW_0_1000,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1000 },
+                { TextureID::TERRAIN_TILE_SNOW_0_1001,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1001 },
+                { TextureID::TERRAIN_TILE_SNOW_0_1010,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1010 },
+                { TextureID::TERRAIN_TILE_SNOW_0_1011,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1011 },
+                { TextureID::TERRAIN_TILE_SNOW_0_1100,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1100 },
+                { TextureID::TERRAIN_TILE_SNOW_0_1101,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1101 },
+                { TextureID::TERRAIN_TILE_SNOW_0_1110,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1110 },
+                { TextureID::TERRAIN_TILE_SNOW_0_1111,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_0_1111 },
+                { TextureID::TERRAIN_TILE_SNOW_1_0000,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0000 },
+                { TextureID::TERRAIN_TILE_SNOW_1_0001,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0001 },
+                { TextureID::TERRAIN_TILE_SNOW_1_0010,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0010 },
+                { TextureID::TERRAIN_TILE_SNOW_1_0011,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0011 },
+                { TextureID::TERRAIN_TILE_SNOW_1_0100,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0100 },
+                { TextureID::TERRAIN_TILE_SNOW_1_0101,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0101 },
+                { TextureID::TERRAIN_TILE_SNOW_1_0110,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0110 },
+                { TextureID::TERRAIN_TILE_SNOW_1_0111,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_0111 },
+                { TextureID::TERRAIN_TILE_SNOW_1_1000,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1000 },
+                { TextureID::TERRAIN_TILE_SNOW_1_1001,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1001 },
+                { TextureID::TERRAIN_TILE_SNOW_1_1010,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1010 },
+                { TextureID::TERRAIN_TILE_SNOW_1_1011,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1011 },
+                { TextureID::TERRAIN_TILE_SNOW_1_1100,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1100 },
+                { TextureID::TERRAIN_TILE_SNOW_1_1101,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1101 },
+                { TextureID::TERRAIN_TILE_SNOW_1_1110,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1110 },
+                { TextureID::TERRAIN_TILE_SNOW_1_1111,        PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_SNOW_1_1111 }
+                
+//                 { TextureID::TERRAIN_TILE_DESERT_01,          PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_DESERT_01 },
+//                 { TextureID::TERRAIN_TILE_WATER_01,           PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_WATER_01 },
+//                 { TextureID::TERRAIN_TILE_GRASS_01,           PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_01 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_01,    PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_01 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_02,    PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_02 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_012,   PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_012 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_013,   PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_013 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_112,   PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_112 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_113,   PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_113 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_114,   PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_114 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_01432, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_01432 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_11432, PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_11432 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_132,   PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_132 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_134,   PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_134 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_03,    PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_03 },
+//                 { TextureID::TERRAIN_TILE_GRASS_DESERT_04,    PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_GRASS_DESERT_04 },
+//                 { TextureID::TERRAIN_TILE_BEACH_01,           PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_01 },
+//                 { TextureID::TERRAIN_TILE_BEACH_014,          PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_014 },
+//                 { TextureID::TERRAIN_TILE_BEACH_02,           PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_02 },
+//                 { TextureID::TERRAIN_TILE_BEACH_023,          PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_023 },
+//                 { TextureID::TERRAIN_TILE_BEACH_03,           PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_03 },
+//                 { TextureID::TERRAIN_TILE_BEACH_032,          PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_032 },
+//                 { TextureID::TERRAIN_TILE_BEACH_04,           PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_04 },
+//                 { TextureID::TERRAIN_TILE_BEACH_013,          PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_013 },
+//                 { TextureID::TERRAIN_TILE_BEACH_113,          PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_113 },
+//                 { TextureID::TERRAIN_TILE_BEACH_123,          PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_123 },
+//                 { TextureID::TERRAIN_TILE_BEACH_0013,         PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_0013 },
+//                 { TextureID::TERRAIN_TILE_BEACH_1113,         PATH_TERRAIN_TEXTURES + TEXTURE_TILE_TERRAIN_BEACH_1113 },
+            },
+            {}
+        };
+        
+        static const ResourceManager::AssetSet emptySet = {};
+        
+        switch ( state )
+        {
+            case State::MAIN_MENU:
+                return mainMenuSet;
+            
+            case State::PLAYING:
+            case State::MAP_EDITOR:
+                return mapSet;
+            
+            default:
+                return emptySet;
+        }
+    }
+    
+    bool Game::assetSetReady( const State state )
+    {
+        const ResourceManager::AssetSet& assetSet = getAssetSet( state );
+        
+        // Checked every time, the textures of a set no state uses may have been unloaded
+        if ( ResourceManager::getLoadingProgress( assetSet ) < 1.f )
+            return false;
+        
+        if ( m_readySets.find( state ) != m_readySets.end() )
+            return true;
+        
+        if ( !ResourceManager::addFonts( assetSet.m_fonts ) )
+            LOG(Logger::Level::ERROR) << "Unable to add all the fonts of a state." << std::endl;
+        
+        // Pack the terrain textures together so the map can be drawn without texture switches
+        if ( state == State::MAP_EDITOR || state == State::PLAYING )
+        {
+            if ( !ResourceManager::buildTerrainAtlas() )
+                LOG(Logger::Level::ERROR) << "Unable to build the terrain atlas, terrain will be drawn from individual textures." << std::endl;
+        }
+        
+        m_readySets.insert( state );
+        
+        return true;
+    }
+    
 //     Game::~Game()
 //     {
 //         while ( peekState() )
@@ -1030,6 +358,16 @@ namespace rts
         sf::Time updateTime = sf::Time::Zero;
         unsigned frames = 0;
         
+        // Window & events stay on this thread as SFML requires, only
+        // the updates move over to the simulation thread
+        std::thread simulation;
+        
+        if ( SIMULATION_THREAD )
+        {
+            m_simulating = true;
+            simulation = std::thread( &Game::simulate, this );
+        }
+        
         while ( m_window.isOpen() && m_running && !m_states.empty() )
         {
             sf::Vector2i mousePos = sf::Mouse::getPosition( m_window );
@@ -1037,21 +375,51 @@ namespace rts
             sf::Time elapsedTime = clock.restart();
             accumulator += elapsedTime;
             
+            // Bring in the assets decoded in the background since the last frame
+            ResourceManager::uploadPendingTextures( TEXTURE_UPLOAD_BUDGET );
+            
+            // Make room for them by unloading what no state uses any more
+            ResourceManager::trimTextures();
+            
             if ( !peekState() )
                 continue;
             
-            while ( accumulator > FRAME_TIME )
+            // How far past the last update this frame is drawn, in updates
+            float alpha = 0.f;
+            
             {
-                accumulator -= FRAME_TIME;
+                std::lock_guard<std::mutex> lock( m_stateMutex );
                 
-                if ( peekState() )
+                if ( SIMULATION_THREAD && peekState()->concurrentUpdate() )
                 {
+                    // Updated by the simulation thread, the input is
+                    // still read here, once per frame
                     peekState()->handleInput();
+                    accumulator = sf::Time::Zero;
                     
-                    if (m_active)
-                        peekState()->update( FRAME_TIME );
+                    sf::Time sinceStep = m_stepClock.getElapsedTime() - sf::microseconds( m_lastStep );
+                    alpha = sinceStep.asSeconds() / FRAME_TIME.asSeconds();
+                }
+                else
+                {
+                    while ( accumulator > FRAME_TIME )
+                    {
+                        accumulator -= FRAME_TIME;
+                        
+                        if ( peekState() )
+                        {
+                            peekState()->handleInput();
+                            
+                            if (m_active)
+                                peekState()->update( FRAME_TIME );
+                        }
+                    }
+                    
+                    alpha = accumulator.asSeconds() / FRAME_TIME.asSeconds();
                 }
             }
+            
+            alpha = std::min( alpha, 1.f );
                         
             if (m_active)
             {
@@ -1065,26 +433,68 @@ namespace rts
                     frames = 0;
                 }
                 
-                m_mousePointer.setPosition( m_window.mapPixelToCoords( mousePos ) );
-                
                 m_window.clear( sf::Color::Black );
                 m_window.draw( m_backgroundSprite );
                 
                 if ( peekState() )
-                    peekState()->draw(FRAME_TIME);
+                    peekState()->draw( alpha );
                 
                 CManager::UIComponent::renderUIComponents( m_window );
                 
+                // After the state has set the view of this frame
+                m_mousePointer.setPosition( m_window.mapPixelToCoords( mousePos ) );
+                
                 m_window.draw( m_fps );
                 m_window.draw( m_mousePointer );
                 m_window.display();
             }
         }
         
+        if ( simulation.joinable() )
+        {
+            m_simulating = false;
+            simulation.join();
+        }
+        
         LOG(Logger::Level::INFO) << "Game stopped..." << std::endl;
         close();
     }
     
+    void Game::simulate()
+    {
+        sf::Clock clock;
+        sf::Time accumulator = sf::Time::Zero;
+        
+        while ( m_simulating )
+        {
+            accumulator += clock.restart();
+            
+            while ( accumulator > FRAME_TIME )
+            {
+                accumulator -= FRAME_TIME;
+                
+                std::lock_guard<std::mutex> lock( m_stateMutex );
+                
+                auto state = peekState();
+                
+                // The other states are updated on the main thread, don't
+                // catch up on the time spent in them later
+                if ( !state || !state->concurrentUpdate() )
+                {
+                    accumulator = sf::Time::Zero;
+                    break;
+                }
+                
+                if ( m_active )
+                    state->update( FRAME_TIME );
+                
+                m_lastStep = m_stepClock.getElapsedTime().asMicroseconds();
+            }
+            
+            sf::sleep( FRAME_TIME - accumulator );
+        }
+    }
+    
     void Game::close()
     {
         m_running = false;
@@ -1093,6 +503,20 @@ namespace rts
     
     void rts::Game::pushState(const rts::Game::State state)
     {
+        // Bring back whatever was unloaded since the state was last used
+        ResourceManager::requestAssetSet( getAssetSet( state ) );
+        
+        // A state whose assets are still streaming in waits behind a loading
+        // screen, which keeps them from being unloaded as they arrive
+        if ( !assetSetReady( state ) )
+        {
+            m_states.push( std::make_shared<LoadingState>( this, state ) );
+            m_states.top()->pinAssetSet( getAssetSet( state ) );
+            return;
+        }
+        
+        std::size_t depth = m_states.size();
+        
         switch ( state )
         {
             case State::MAIN_MENU:
@@ -1135,6 +559,10 @@ namespace rts
                 LOG(Logger::Level::ERROR) << "Invalid state" << std::endl;
             }
         }
+        
+        // The state keeps its assets loaded until it is popped
+        if ( m_states.size() > depth )
+            m_states.top()->pinAssetSet( getAssetSet( state ) );
     }
     
     void rts::Game::popState()
@@ -0,0 +1,122 @@
+/*
+ * ---------------------------
+ *  Module    : GameStates
+ *  Submodule : LoadingState
+ * ---------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 01-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  Contains implementation of the methods & classes declared
+ *  in LoadingState submodule.
+ */
+
+#include <string>
+
+#include <SFML/Window/Event.hpp>
+
+#include "Utility/Constants.hpp"
+#include "Utility/Log.hpp"
+#include "ResourceManager/ResourceManager.hpp"
+#include "GameStates/LoadingState.hpp"
+
+namespace rts
+{
+    LoadingState::LoadingState(Game::Ptr game, const Game::State target) :
+     m_target( target )
+    {
+        m_game = game;
+        
+        sf::Vector2f windowSize = static_cast<sf::Vector2f>( m_game->m_window.getSize() );
+        sf::Vector2f barSize{ windowSize.x / 3.f, 12.f };
+        sf::Vector2f barPos{ ( windowSize.x - barSize.x ) / 2.f, windowSize.y * 0.75f };
+        
+        m_barFrame.setSize( barSize );
+        m_barFrame.setPosition( barPos );
+        m_barFrame.setFillColor( sf::Color( 0, 0, 0, 120 ) );
+        m_barFrame.setOutlineColor( sf::Color( 200, 200, 200 ) );
+        m_barFrame.setOutlineThickness( 1.f );
+        
+        m_bar.setSize( sf::Vector2f{ 0.f, barSize.y } );
+        m_bar.setPosition( barPos );
+        m_bar.setFillColor( sf::Color( 200, 200, 200 ) );
+        
+        m_caption.setFont( *ResourceManager::getFont( FontID::DEFAULT ) );
+        m_caption.setCharacterSize( 14 );
+        m_caption.setFillColor( sf::Color::White );
+        m_caption.setString( "Loading..." );
+        m_caption.setPosition( barPos.x, barPos.y - 24.f );
+        
+        LOG(Logger::Level::DEBUG) << "LoadingState object created" << std::endl;
+    }
+    
+    LoadingState::~LoadingState()
+    {
+        LOG(Logger::Level::DEBUG) << "LoadingState object destroyed" << std::endl;
+    }
+    
+    void LoadingState::handleInput()
+    {
+        if (m_game->m_window.isOpen())
+        {
+            sf::Event event;
+            
+            while (m_game->m_window.pollEvent(event))
+            {
+                switch (event.type)
+                {
+                    case sf::Event::Closed:
+                    {
+                        m_game->m_window.close();
+                    } break;
+                    
+                    case sf::Event::LostFocus:
+                    {
+                        m_game->m_active = false;
+                    } break;
+                    
+                    case sf::Event::GainedFocus:
+                    {
+                        m_game->m_active = true;
+                    } break;
+                    
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+    
+    void LoadingState::update(const sf::Time dt)
+    {
+        if ( m_game->assetSetReady( m_target ) )
+        {
+            // Take the place of this state, leaving the one below frozen
+            Game::State target = m_target;
+            Game::Ptr game = m_game;
+            
+            game->m_states.pop();
+            game->pushState( target );
+            return;
+        }
+        
+        float progress = ResourceManager::getLoadingProgress( Game::getAssetSet( m_target ) );
+        
+        m_bar.setSize( sf::Vector2f{ m_barFrame.getSize().x * progress, m_barFrame.getSize().y } );
+        m_caption.setString( "Loading... " + std::to_string( static_cast<int>( progress * 100.f ) ) + "%" );
+    }
+    
+    void LoadingState::draw(const float alpha)
+    {
+        m_game->m_window.draw( m_barFrame );
+        m_game->m_window.draw( m_bar );
+        m_game->m_window.draw( m_caption );
+    }
+    
+    void LoadingState::freeze(bool f)
+    {
+    }
+}
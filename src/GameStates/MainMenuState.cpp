@@ -213,7 +213,7 @@ namespace rts
         //m_console.update(dt);
     }
     
-    void MainMenuState::draw(const sf::Time dt)
+    void MainMenuState::draw(const float alpha)
     {
         //m_game->m_window.draw( m_testSprite );
         //auto tex = ResourceManager::getTexture( TextureID::TERRAIN_ANIMATED_TILE_WATER_DEFAULT );
@@ -105,6 +105,8 @@ namespace rts
     
     void MapEditorState::handleInput()
     {
+        m_map.handleInput();
+        
         if (m_game->m_window.isOpen())
         {
             sf::Event event;            
@@ -160,6 +162,12 @@ namespace rts
     void MapEditorState::update( const sf::Time dt )
     {
         m_map.update( dt );
+    }
+    
+    void MapEditorState::draw( const float alpha )
+    {
+        // Take in the latest update of the map, then keep the UI over its view
+        m_map.prepareFrame( alpha );
         
         m_rects[MAIN_TITLE].setPosition( m_game->m_window.mapPixelToCoords( sf::Vector2i{ 5, 5 } ) );
         m_rects[MENU_BAR].setPosition( m_game->m_window.mapPixelToCoords( sf::Vector2i{ 142, 5 } ) );   
@@ -171,15 +179,17 @@ namespace rts
         UIManager::UIButton::setPosition( "ExitMEButton", static_cast<sf::Vector2f>( m_game->m_window.mapPixelToCoords( { 148 + 118 + 113 + 131, 12 } ) ) );
                 
         UIManager::UITileBox::setPosition( "MapTileBox", static_cast<sf::Vector2f>( m_game->m_window.mapPixelToCoords( { 5, 60 } ) ) );
-    }
-    
-    void MapEditorState::draw( const sf::Time dt )
-    {
+        
         m_game->m_window.draw( m_map );
         for ( auto&& rect : m_rects )
             m_game->m_window.draw( rect );
     }
     
+    bool MapEditorState::concurrentUpdate() const
+    {
+        return true;
+    }
+    
     void MapEditorState::freeze(bool f)
     {
         auto tex = ResourceManager::getTexture( TextureID::MAP_EDITOR_BACKGROUND );
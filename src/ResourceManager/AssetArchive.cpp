@@ -0,0 +1,180 @@
+/*
+ * --------------------------------
+ *  Module    : ResourceManager
+ *  Submodule : AssetArchive
+ * --------------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 01-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  Contains implementation of the methods & classes declared
+ *  in AssetArchive submodule.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+    #define RTS_ASSET_ARCHIVE_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "Utility/Log.hpp"
+#include "ResourceManager/AssetArchive.hpp"
+
+namespace rts
+{
+    AssetArchive::AssetArchive() :
+     m_data( nullptr ),
+     m_size( 0 ),
+     m_entries( nullptr ),
+     m_entryCount( 0 ),
+     m_mapped( false )
+    {
+    }
+    
+    AssetArchive::~AssetArchive()
+    {
+        close();
+    }
+    
+    bool AssetArchive::open( const std::string& path )
+    {
+        close();
+        
+#ifdef RTS_ASSET_ARCHIVE_MMAP
+        int fd = ::open( path.c_str(), O_RDONLY );
+        if ( fd < 0 )
+            return false;
+        
+        struct stat info;
+        if ( ::fstat( fd, &info ) != 0 || info.st_size <= 0 )
+        {
+            ::close( fd );
+            return false;
+        }
+        
+        void* data = ::mmap( nullptr, static_cast<std::size_t>( info.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+        
+        // The mapping outlives the descriptor
+        ::close( fd );
+        
+        if ( data == MAP_FAILED )
+        {
+            LOG(Logger::Level::ERROR) << "Unable to map the asset archive: " << path << std::endl;
+            return false;
+        }
+        
+        m_data = static_cast<const char*>( data );
+        m_size = static_cast<std::size_t>( info.st_size );
+        m_mapped = true;
+#else
+        std::ifstream file( path, std::ios::binary );
+        if ( !file.is_open() )
+            return false;
+        
+        m_buffer.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+        
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+#endif
+        
+        if ( !validate() )
+        {
+            LOG(Logger::Level::ERROR) << "Invalid asset archive: " << path << std::endl;
+            close();
+            return false;
+        }
+        
+        LOG(Logger::Level::DEBUG) << "Opened asset archive " << path << " with " << m_entryCount << " files." << std::endl;
+        
+        return true;
+    }
+    
+    void AssetArchive::close()
+    {
+#ifdef RTS_ASSET_ARCHIVE_MMAP
+        if ( m_mapped )
+            ::munmap( const_cast<char*>( m_data ), m_size );
+#endif
+        
+        m_buffer.clear();
+        m_buffer.shrink_to_fit();
+        
+        m_data = nullptr;
+        m_size = 0;
+        m_entries = nullptr;
+        m_entryCount = 0;
+        m_mapped = false;
+    }
+    
+    bool AssetArchive::isOpen() const
+    {
+        return m_entries != nullptr;
+    }
+    
+    bool AssetArchive::find( const std::string& path, const void*& data, std::size_t& size ) const
+    {
+        if ( !isOpen() )
+            return false;
+        
+        std::uint64_t id = hashPath( path );
+        
+        auto end = m_entries + m_entryCount;
+        auto it = std::lower_bound( m_entries, end, id, []( const AssetArchiveEntry& entry, const std::uint64_t value )
+        {
+            return entry.m_id < value;
+        } );
+        
+        if ( it == end || it->m_id != id )
+            return false;
+        
+        data = m_data + it->m_offset;
+        size = static_cast<std::size_t>( it->m_size );
+        
+        return true;
+    }
+    
+    bool AssetArchive::validate()
+    {
+        if ( m_size < sizeof( AssetArchiveHeader ) )
+            return false;
+        
+        AssetArchiveHeader header;
+        std::memcpy( &header, m_data, sizeof( header ) );
+        
+        if ( std::memcmp( header.m_magic, ASSET_ARCHIVE_MAGIC, sizeof( header.m_magic ) ) != 0 ||
+             header.m_version != ASSET_ARCHIVE_VERSION )
+            return false;
+        
+        std::size_t tableEnd = sizeof( AssetArchiveHeader ) + header.m_entryCount * sizeof( AssetArchiveEntry );
+        if ( tableEnd > m_size )
+            return false;
+        
+        // The entries follow the 16 byte header, so they are aligned
+        auto entries = reinterpret_cast<const AssetArchiveEntry*>( m_data + sizeof( AssetArchiveHeader ) );
+        
+        for ( std::uint32_t i = 0; i < header.m_entryCount; ++i )
+        {
+            if ( entries[i].m_offset < tableEnd ||
+                 entries[i].m_offset > m_size ||
+                 entries[i].m_size > m_size - entries[i].m_offset )
+                return false;
+            
+            if ( i > 0 && entries[i - 1].m_id >= entries[i].m_id )
+                return false;
+        }
+        
+        m_entries = entries;
+        m_entryCount = header.m_entryCount;
+        
+        return true;
+    }
+}
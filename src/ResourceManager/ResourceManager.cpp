@@ -13,100 +13,551 @@
  *  in ResourceManager module.
  */
 
+#include <algorithm>
+#include <map>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Clock.hpp>
+
 #include "Utility/Log.hpp"
 #include "Utility/Constants.hpp"
+#include "Utility/ThreadPool.hpp"
 #include "ResourceManager/ResourceManager.hpp"
 
 namespace rts
 {
-    // Initialize the texture and font maps
+    // The archive is defined first so that it is closed after
+    // the fonts reading from it are destroyed
+    AssetArchive ResourceManager::m_archive;
+    
+    // Initialize the texture and font tables
+    
+    std::unique_ptr<sf::Texture> ResourceManager::m_textures[static_cast<int>( TextureID::MAX_TEXTURES )] = {};
+    
+    std::unique_ptr<sf::Font> ResourceManager::m_fonts[static_cast<int>( FontID::MAX_FONTS )] = {};
+    
+    std::atomic<const sf::Texture*> ResourceManager::m_textureSlots[static_cast<int>( TextureID::MAX_TEXTURES )] = {};
+    
+    std::atomic<const sf::Font*> ResourceManager::m_fontSlots[static_cast<int>( FontID::MAX_FONTS )] = {};
+    
+    std::deque<std::shared_ptr<ResourceManager::PendingTexture>> ResourceManager::m_pendingTextures = {};
+    
+    std::set<TextureID> ResourceManager::m_failedTextures = {};
+    
+    std::vector<std::shared_ptr<sf::Texture>> ResourceManager::m_atlasPages = {};
+    
+    int ResourceManager::m_pinCount[static_cast<int>( TextureID::MAX_TEXTURES )] = {};
+    
+    unsigned long ResourceManager::m_lastUsed[static_cast<int>( TextureID::MAX_TEXTURES )] = {};
     
-    std::map<TextureID, std::shared_ptr<sf::Texture>> ResourceManager::m_texturesHandleMap = {};
+    unsigned long ResourceManager::m_useClock = 0;
     
-    std::map<FontID, std::shared_ptr<sf::Font>> ResourceManager::m_fontsHandleMap = {};
+    std::size_t ResourceManager::m_residentBytes[static_cast<int>( TextureCategory::MAX_CATEGORIES )] = {};
+    
+    std::size_t ResourceManager::m_memoryBudget = TEXTURE_MEMORY_BUDGET;
+    
+    ResourceManager::AtlasRegion ResourceManager::m_atlasRegions[static_cast<int>( TextureID::MAX_TEXTURES )] = {};
     
     
     ResourceManager::ResourceManager()
     {}
-
+    
     ResourceManager::~ResourceManager()
     {}
-
+    
     bool ResourceManager::addTexture(const TextureID texID, const std::string& texFile)
     {
-        if (textureIDToStr(texID) == "")
+        if (!isValidTexture(texID))
         {
             LOG(Logger::Level::ERROR) << "[ FATAL ] No texture ID called: " << textureIDToStr(texID) << " exists." << std::endl;
             return false;
         }
-
-        sf::Texture* texture = new sf::Texture();
-
-        if (texture->loadFromFile(texFile))
+        
+        std::unique_ptr<sf::Texture> texture( new sf::Texture() );
+        
+        const void* data;
+        std::size_t size;
+        
+        bool loaded = m_archive.find( texFile, data, size ) ? texture->loadFromMemory( data, size )
+                                                            : texture->loadFromFile( texFile );
+        
+        if (loaded)
             LOG(Logger::Level::DEBUG) << "Successfully loaded texture: " << textureIDToStr(texID) << std::endl;
         else
         {
             LOG(Logger::Level::ERROR) << "[ FATAL ] Unable to load texture: " << textureIDToStr(texID) << std::endl;
             return false;
         }
-
-        m_texturesHandleMap.insert(std::make_pair(texID, std::shared_ptr<sf::Texture>(std::move(texture))));
-
+        
+        storeTexture(texID, std::move(texture));
+        
         return true;
     }
-
-    std::shared_ptr<sf::Texture> ResourceManager::getTexture(const TextureID texID)
+    
+    bool ResourceManager::addTextures(const std::vector<TextureFile>& textures)
+    {
+        sf::Clock clock;
+        
+        // Decode the files on the workers, into one image each. Nothing
+        // is logged from there as the logger is not thread safe.
+        std::vector<sf::Image> images( textures.size() );
+        std::vector<char> decoded( textures.size(), false );
+        
+        ThreadPool::getInstance().parallelFor( textures.size(), 1, [&]( std::size_t begin, std::size_t end )
+        {
+            for ( std::size_t i = begin; i < end; ++i )
+                decoded[i] = loadImage( images[i], textures[i].m_file );
+        } );
+        
+        sf::Time decodeTime = clock.restart();
+        
+        // Upload them on this thread, which owns the GL context
+        bool allLoaded = true;
+        
+        for ( std::size_t i = 0; i < textures.size(); ++i )
+        {
+            if ( !decoded[i] )
+            {
+                LOG(Logger::Level::ERROR) << "[ FATAL ] Unable to load texture: " << textureIDToStr(textures[i].m_id) << std::endl;
+                m_failedTextures.insert( textures[i].m_id );
+                allLoaded = false;
+                continue;
+            }
+            
+            if ( !uploadTexture( textures[i].m_id, images[i] ) )
+                allLoaded = false;
+        }
+        
+        LOG(Logger::Level::INFO) << "Loaded " << textures.size() << " textures: decoded in " << decodeTime.asMilliseconds()
+                                 << " ms on " << ThreadPool::getInstance().getWorkerCount() + 1 << " threads, uploaded in "
+                                 << clock.getElapsedTime().asMilliseconds() << " ms." << std::endl;
+        
+        return allLoaded;
+    }
+    
+    bool ResourceManager::openArchive(const std::string& archiveFile)
+    {
+        return m_archive.open( archiveFile );
+    }
+    
+    bool ResourceManager::loadImage(sf::Image& image, const std::string& file)
+    {
+        const void* data;
+        std::size_t size;
+        
+        if ( m_archive.find( file, data, size ) )
+            return image.loadFromMemory( data, size );
+        
+        return image.loadFromFile( file );
+    }
+    
+    bool ResourceManager::uploadTexture(const TextureID texID, const sf::Image& image)
     {
-        if (textureIDToStr(texID) == "")
+        if (!isValidTexture(texID))
+        {
+            LOG(Logger::Level::ERROR) << "[ FATAL ] No texture ID called: " << textureIDToStr(texID) << " exists." << std::endl;
+            return false;
+        }
+        
+        std::unique_ptr<sf::Texture> texture( new sf::Texture() );
+        
+        if (texture->loadFromImage(image))
+            LOG(Logger::Level::DEBUG) << "Successfully loaded texture: " << textureIDToStr(texID) << std::endl;
+        else
+        {
+            LOG(Logger::Level::ERROR) << "[ FATAL ] Unable to upload texture: " << textureIDToStr(texID) << std::endl;
+            m_failedTextures.insert( texID );
+            return false;
+        }
+        
+        storeTexture(texID, std::move(texture));
+        
+        return true;
+    }
+    
+    bool ResourceManager::addFonts(const std::vector<FontFile>& fonts)
+    {
+        bool allLoaded = true;
+        
+        for ( auto&& font : fonts )
+        {
+            if ( findFont( font.m_id ) )
+                continue;
+            
+            if ( !addFont( font.m_id, font.m_file ) )
+                allLoaded = false;
+        }
+        
+        return allLoaded;
+    }
+    
+    bool ResourceManager::loadAssetSet(const AssetSet& assetSet)
+    {
+        std::vector<TextureFile> textures;
+        for ( auto&& texture : assetSet.m_textures )
+            if ( !textureRequested( texture.m_id ) )
+                textures.push_back( texture );
+        
+        bool texturesLoaded = addTextures( textures );
+        bool fontsLoaded = addFonts( assetSet.m_fonts );
+        
+        return texturesLoaded && fontsLoaded;
+    }
+    
+    void ResourceManager::requestAssetSet(const AssetSet& assetSet)
+    {
+        for ( auto&& texture : assetSet.m_textures )
+        {
+            if ( textureRequested( texture.m_id ) )
+                continue;
+            
+            auto pending = std::make_shared<PendingTexture>();
+            pending->m_id = texture.m_id;
+            pending->m_file = texture.m_file;
+            pending->m_status = 0;
+            
+            m_pendingTextures.push_back( pending );
+            
+            // The task keeps its texture alive, whatever happens to the queue
+            ThreadPool::getInstance().submit( [pending]()
+            {
+                pending->m_status = loadImage( pending->m_image, pending->m_file ) ? 1 : -1;
+            } );
+        }
+    }
+    
+    void ResourceManager::uploadPendingTextures(const sf::Time budget)
+    {
+        sf::Clock clock;
+        
+        for ( auto it = m_pendingTextures.begin(); it != m_pendingTextures.end() && clock.getElapsedTime() < budget; )
+        {
+            int status = ( *it )->m_status;
+            
+            if ( status == 0 )
+            {
+                ++it;
+                continue;
+            }
+            
+            if ( status > 0 )
+                uploadTexture( ( *it )->m_id, ( *it )->m_image );
+            else
+            {
+                LOG(Logger::Level::ERROR) << "[ FATAL ] Unable to load texture: " << textureIDToStr( ( *it )->m_id ) << std::endl;
+                m_failedTextures.insert( ( *it )->m_id );
+            }
+            
+            it = m_pendingTextures.erase( it );
+        }
+    }
+    
+    float ResourceManager::getLoadingProgress(const AssetSet& assetSet)
+    {
+        if ( assetSet.m_textures.empty() )
+            return 1.f;
+        
+        std::size_t done = 0;
+        
+        for ( auto&& texture : assetSet.m_textures )
+            if ( findTexture( texture.m_id ) ||
+                 m_failedTextures.find( texture.m_id ) != m_failedTextures.end() )
+                ++done;
+        
+        return static_cast<float>( done ) / assetSet.m_textures.size();
+    }
+    
+    bool ResourceManager::textureRequested(const TextureID texID)
+    {
+        if ( findTexture( texID ) ||
+             m_failedTextures.find( texID ) != m_failedTextures.end() )
+            return true;
+        
+        for ( auto&& pending : m_pendingTextures )
+            if ( pending->m_id == texID )
+                return true;
+        
+        return false;
+    }
+    
+    void ResourceManager::pinAssetSet(const AssetSet& assetSet)
+    {
+        for ( auto&& texture : assetSet.m_textures )
+            if ( isValidTexture( texture.m_id ) )
+                ++m_pinCount[static_cast<int>( texture.m_id )];
+    }
+    
+    void ResourceManager::releaseAssetSet(const AssetSet& assetSet)
+    {
+        for ( auto&& texture : assetSet.m_textures )
+        {
+            if ( !isValidTexture( texture.m_id ) )
+                continue;
+            
+            int slot = static_cast<int>( texture.m_id );
+            if ( m_pinCount[slot] > 0 && --m_pinCount[slot] == 0 )
+                m_lastUsed[slot] = ++m_useClock;
+        }
+    }
+    
+    void ResourceManager::setMemoryBudget(const std::size_t bytes)
+    {
+        m_memoryBudget = bytes;
+    }
+    
+    void ResourceManager::trimTextures()
+    {
+        ResidencyStats stats = getResidencyStats();
+        if ( stats.m_totalBytes <= m_memoryBudget )
+            return;
+        
+        int evicted = 0;
+        
+        while ( stats.m_totalBytes > m_memoryBudget )
+        {
+            // The unpinned texture released longest ago
+            int victim = -1;
+            for ( int t = 0; t < static_cast<int>( TextureID::MAX_TEXTURES ); ++t )
+                if ( m_textures[t] && m_pinCount[t] == 0 && ( victim < 0 || m_lastUsed[t] < m_lastUsed[victim] ) )
+                    victim = t;
+            
+            // Everything left is in use
+            if ( victim < 0 )
+                break;
+            
+            stats.m_totalBytes -= textureBytes( *m_textures[victim] );
+            evictTexture( static_cast<TextureID>( victim ) );
+            ++evicted;
+        }
+        
+        // Report only when something changed, the pinned textures alone
+        // may stay over the budget for many frames
+        if ( evicted == 0 )
+            return;
+        
+        LOG(Logger::Level::DEBUG) << "Unloaded " << evicted << " texture(s), " << stats.m_totalBytes / 1024 << " KiB of textures resident, budget "
+                                  << m_memoryBudget / 1024 << " KiB." << std::endl;
+        
+        if ( stats.m_totalBytes > m_memoryBudget )
+            LOG(Logger::Level::ERROR) << "The pinned textures do not fit in the texture memory budget." << std::endl;
+    }
+    
+    ResourceManager::ResidencyStats ResourceManager::getResidencyStats()
+    {
+        ResidencyStats stats{};
+        
+        for ( int c = 0; c < static_cast<int>( TextureCategory::MAX_CATEGORIES ); ++c )
+        {
+            stats.m_bytes[c] = m_residentBytes[c];
+            stats.m_totalBytes += m_residentBytes[c];
+        }
+        
+        for ( int t = 0; t < static_cast<int>( TextureID::MAX_TEXTURES ); ++t )
+        {
+            if ( !m_textures[t] )
+                continue;
+            
+            ++stats.m_resident;
+            if ( m_pinCount[t] > 0 )
+                ++stats.m_pinned;
+        }
+        
+        stats.m_budget = m_memoryBudget;
+        
+        return stats;
+    }
+    
+    const sf::Texture* ResourceManager::getTexture(const TextureID texID)
+    {
+        if (!isValidTexture(texID))
         {
             LOG(Logger::Level::ERROR) << "[ FATAL ] No texture ID called: " << textureIDToStr(texID) << " exists." << std::endl;
             return nullptr;
         }
         
-        auto it = m_texturesHandleMap.find( texID );
-        if ( it != m_texturesHandleMap.end() )
-            return it->second;
+        if ( auto texture = findTexture( texID ) )
+            return texture;
         
         LOG(Logger::Level::ERROR) << "[ FATAL ] Unable to access texture: " << textureIDToStr(texID) << "." << std::endl;
         return nullptr;
     }
-
+    
     bool ResourceManager::addFont(const FontID fontID, const std::string& fontFile)
     {
-        if (fontIDToStr(fontID) == "")
+        if (!isValidFont(fontID))
         {
             LOG(Logger::Level::ERROR) << "[ FATAL ] No font ID called: " << fontIDToStr(fontID) << " exists." << std::endl;
             return false;
         }
-
-        sf::Font* font = new sf::Font();
-
-        if (font->loadFromFile(fontFile))
+        
+        std::unique_ptr<sf::Font> font( new sf::Font() );
+        
+        // A font reads its file as it goes, from the archive it does so without a copy
+        const void* data;
+        std::size_t size;
+        
+        bool loaded = m_archive.find( fontFile, data, size ) ? font->loadFromMemory( data, size )
+                                                             : font->loadFromFile( fontFile );
+        
+        if (loaded)
             LOG(Logger::Level::DEBUG) << "Successfully loaded font: " << fontIDToStr(fontID) << std::endl;
         else
         {
             LOG(Logger::Level::ERROR) << "[ FATAL ] Unable to load font: " << fontIDToStr(fontID) << std::endl;
             return false;
         }
-
-        m_fontsHandleMap.insert(std::make_pair(fontID, std::shared_ptr<sf::Font>(std::move(font))));
-
+        
+        // A font already loaded keeps its address, it may be in use
+        int slot = static_cast<int>( fontID );
+        if ( !m_fonts[slot] )
+        {
+            m_fonts[slot] = std::move( font );
+            m_fontSlots[slot].store( m_fonts[slot].get(), std::memory_order_release );
+        }
+        
         return true;
     }
-
-    std::shared_ptr<sf::Font> ResourceManager::getFont(const FontID fontID)
+    
+    const sf::Font* ResourceManager::getFont(const FontID fontID)
     {
-        if (fontIDToStr(fontID) == "")
+        if (!isValidFont(fontID))
         {
             LOG(Logger::Level::ERROR) << "[ FATAL ] No font ID called: " << fontIDToStr(fontID) << " exists." << std::endl;
             return nullptr;
         }
-
-        auto it = m_fontsHandleMap.find( fontID );
-        if ( it != m_fontsHandleMap.end() )
-            return it->second;
         
-        return nullptr;
+        return findFont( fontID );
+    }
+    
+    bool ResourceManager::buildTerrainAtlas()
+    {
+        // Gap between two packed textures, to keep filtering from bleeding
+        const unsigned padding = 2;
+        
+        // Keep the pages within what even low end GPUs support
+        const unsigned pageSize = std::min( sf::Texture::getMaximumSize(), 2048u );
+        
+        clearAtlas();
+        
+        // Collect the terrain textures, tallest first for tighter shelves
+        std::vector<TextureID> textures;
+        for ( int t = 0; t < static_cast<int>( TextureID::MAX_TEXTURES ); ++t )
+            if ( m_textures[t] && getTerrainType( static_cast<TextureID>( t ) ) != TerrainType::NON_TERRAIN_TEXTURE )
+                textures.push_back( static_cast<TextureID>( t ) );
+        
+        std::stable_sort( textures.begin(), textures.end(), []( TextureID a, TextureID b )
+        {
+            return m_textures[static_cast<int>( a )]->getSize().y > m_textures[static_cast<int>( b )]->getSize().y;
+        } );
+        
+        // Shelf packing: textures are placed left to right on a shelf as
+        // tall as its first texture; a new shelf is opened below when the
+        // current one is full, and a new page when the page is full.
+        std::vector<sf::Image> pages;
+        std::map<TextureID, std::size_t> pageOf;
+        unsigned x = 0, y = 0, shelfHeight = 0;
+        
+        for ( auto&& texID : textures )
+        {
+            const sf::Texture& source = *m_textures[static_cast<int>( texID )];
+            auto size = source.getSize();
+            
+            if ( size.x > pageSize || size.y > pageSize )
+            {
+                LOG(Logger::Level::ERROR) << "Texture too large for the terrain atlas: " << textureIDToStr(texID) << std::endl;
+                continue;
+            }
+            
+            if ( x + size.x > pageSize )
+            {
+                x = 0;
+                y += shelfHeight + padding;
+                shelfHeight = 0;
+            }
+            
+            if ( pages.empty() || y + size.y > pageSize )
+            {
+                pages.emplace_back();
+                pages.back().create( pageSize, pageSize, sf::Color::Transparent );
+                x = y = shelfHeight = 0;
+            }
+            
+            pages.back().copy( source.copyToImage(), x, y );
+            m_atlasRegions[static_cast<int>( texID )].m_rect = sf::IntRect( x, y, size.x, size.y );
+            pageOf[texID] = pages.size() - 1;
+            
+            x += size.x + padding;
+            shelfHeight = std::max( shelfHeight, size.y );
+        }
+        
+        // Upload the pages to the GPU
+        for ( auto&& page : pages )
+        {
+            auto texture = std::make_shared<sf::Texture>();
+            if ( !texture->loadFromImage( page ) )
+            {
+                LOG(Logger::Level::ERROR) << "[ FATAL ] Unable to create the terrain atlas." << std::endl;
+                clearAtlas();
+                return false;
+            }
+            
+            m_atlasPages.push_back( texture );
+            m_residentBytes[static_cast<int>( TextureCategory::TERRAIN_ATLAS )] += textureBytes( *texture );
+        }
+        
+        for ( auto&& packed : pageOf )
+            m_atlasRegions[static_cast<int>( packed.first )].m_texture = m_atlasPages[packed.second].get();
+        
+        LOG(Logger::Level::DEBUG) << "Packed " << pageOf.size() << " terrain textures into " << m_atlasPages.size() << " atlas texture(s)." << std::endl;
+        
+        return true;
+    }
+    
+    ResourceManager::AtlasRegion ResourceManager::getAtlasRegion(const TextureID texID)
+    {
+        if ( isValidTexture( texID ) && m_atlasRegions[static_cast<int>( texID )].m_texture )
+            return m_atlasRegions[static_cast<int>( texID )];
+        
+        auto texture = getTexture( texID );
+        if ( !texture )
+            return AtlasRegion{ nullptr, sf::IntRect() };
+        
+        return AtlasRegion{ texture, sf::IntRect( 0, 0, texture->getSize().x, texture->getSize().y ) };
+    }
+    
+    void ResourceManager::storeTexture(const TextureID texID, std::unique_ptr<sf::Texture> texture)
+    {
+        // A texture already loaded keeps its address, it may be in use
+        int slot = static_cast<int>( texID );
+        if ( m_textures[slot] )
+            return;
+        
+        m_textures[slot] = std::move( texture );
+        m_textureSlots[slot].store( m_textures[slot].get(), std::memory_order_release );
+        
+        m_residentBytes[static_cast<int>( getTextureCategory( texID ) )] += textureBytes( *m_textures[slot] );
+        m_lastUsed[slot] = ++m_useClock;
+    }
+    
+    void ResourceManager::evictTexture(const TextureID texID)
+    {
+        int slot = static_cast<int>( texID );
+        if ( !m_textures[slot] )
+            return;
+        
+        m_textureSlots[slot].store( nullptr, std::memory_order_release );
+        m_residentBytes[static_cast<int>( getTextureCategory( texID ) )] -= textureBytes( *m_textures[slot] );
+        m_textures[slot].reset();
+        
+        LOG(Logger::Level::DEBUG) << "Unloaded texture: " << textureIDToStr( texID ) << std::endl;
+    }
+    
+    void ResourceManager::clearAtlas()
+    {
+        m_atlasPages.clear();
+        m_residentBytes[static_cast<int>( TextureCategory::TERRAIN_ATLAS )] = 0;
+        
+        for ( auto&& region : m_atlasRegions )
+            region = AtlasRegion{ nullptr, sf::IntRect() };
     }
-
 }
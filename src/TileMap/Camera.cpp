@@ -0,0 +1,125 @@
+/*
+ * ------------------------------
+ *  Module    : TileMap
+ *  Submodule : Camera
+ * ------------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 15-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  Contains implementation of the methods & classes declared
+ *  in Camera submodule.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Utility/Constants.hpp"
+#include "TileMap/Camera.hpp"
+
+namespace rts
+{
+    namespace WorldEntities
+    {
+        Camera::Camera( const sf::Vector2f size, const sf::Vector2f center ) :
+         m_view( center, size ),
+         m_previousCenter( center ),
+         m_moved( true )
+        {
+        }
+        
+        void Camera::setBounds( const sf::FloatRect& bounds )
+        {
+            m_bounds = bounds;
+            clamp();
+            
+            // Not a move to blend through
+            m_previousCenter = m_view.getCenter();
+        }
+        
+        void Camera::setScrollDirection( const sf::Vector2f direction )
+        {
+            m_direction = direction;
+        }
+        
+        void Camera::update( const sf::Time dt )
+        {
+            m_previousCenter = m_view.getCenter();
+            
+            // Change the velocity towards the target one by no
+            // more than the acceleration allows in this step
+            float maxChange = CAMERA_SCROLL_ACCELERATION * dt.asSeconds();
+            sf::Vector2f target = m_direction * CAMERA_SCROLL_SPEED;
+            
+            m_velocity.x += std::max( -maxChange, std::min( target.x - m_velocity.x, maxChange ) );
+            m_velocity.y += std::max( -maxChange, std::min( target.y - m_velocity.y, maxChange ) );
+            
+            if ( m_velocity.x == 0.f && m_velocity.y == 0.f )
+                return;
+            
+            m_view.move( m_velocity * dt.asSeconds() );
+            clamp();
+            
+            m_moved = true;
+        }
+        
+        void Camera::apply( sf::RenderTarget& target )
+        {
+            if ( !m_moved )
+                return;
+            
+            target.setView( m_view );
+            m_moved = false;
+        }
+        
+        const sf::View& Camera::getView() const
+        {
+            return m_view;
+        }
+        
+        sf::Vector2f Camera::getPreviousCenter() const
+        {
+            return m_previousCenter;
+        }
+        
+        sf::FloatRect Camera::getViewRect() const
+        {
+            return sf::FloatRect{ m_view.getCenter() - m_view.getSize() * 0.5f, m_view.getSize() };
+        }
+        
+        void Camera::clamp()
+        {
+            sf::Vector2f center = m_view.getCenter();
+            sf::Vector2f half = m_view.getSize() * 0.5f;
+            
+            // Along an axis where the bounds are smaller than the
+            // view, the view is kept centered on them instead
+            auto clampAxis = []( float& c, float& velocity, const float min, const float max, const float halfSize )
+            {
+                float lo = min + halfSize;
+                float hi = max - halfSize;
+                
+                if ( lo > hi )
+                    lo = hi = ( min + max ) * 0.5f;
+                
+                if ( c < lo || c > hi )
+                {
+                    c = std::max( lo, std::min( c, hi ) );
+                    velocity = 0.f;
+                }
+            };
+            
+            clampAxis( center.x, m_velocity.x, m_bounds.left, m_bounds.left + m_bounds.width, half.x );
+            clampAxis( center.y, m_velocity.y, m_bounds.top, m_bounds.top + m_bounds.height, half.y );
+            
+            if ( center != m_view.getCenter() )
+            {
+                m_view.setCenter( center );
+                m_moved = true;
+            }
+        }
+    }
+}
@@ -13,7 +13,9 @@
  *  in TileMap module.
  */
 
+#include <algorithm>
 #include <climits>
+#include <cmath>
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Window/Mouse.hpp>
@@ -30,450 +32,122 @@ namespace rts
 {
     namespace WorldEntities
     {
-        std::map<TerrainType, int> Tile::m_precedences =
+        namespace
         {
-            { TerrainType::WATER, 0 },
-            { TerrainType::GRASS, 1 },
-            { TerrainType::DESERT, 2 },
-            { TerrainType::SNOW, 3 },
-        };
-        
-        TextureID Tile::getOverlayTexture( const std::string& id )
-        {
-            static std::map<std::string, TextureID> m_overlayMap =
+            // The overlay textures of each terrain, indexed by
+            // precedence, overlay (straight/diagonal) & neighbor mask
+            struct OverlayTable
             {
-//                 { "0-0000", TextureID::TERRAIN_TILE_GRASS_0_0000 },
-//                 { "0-0001", TextureID::TERRAIN_TILE_GRASS_0_0001 },
-//                 { "0-0010", TextureID::TERRAIN_TILE_GRASS_0_0010 },
-//                 { "0-0011", TextureID::TERRAIN_TILE_GRASS_0_0011 },
-//                 { "0-0100", TextureID::TERRAIN_TILE_GRASS_0_0100 },
-//                 { "0-0101", TextureID::TERRAIN_TILE_GRASS_0_0101 },
-//                 { "0-0110", TextureID::TERRAIN_TILE_GRASS_0_0110 },
-//                 { "0-0111", TextureID::TERRAIN_TILE_GRASS_0_0111 },
-//                 { "0-1000", TextureID::TERRAIN_TILE_GRASS_0_1000 },
-//                 { "0-1001", TextureID::TERRAIN_TILE_GRASS_0_1001 },
-//                 { "0-1010", TextureID::TERRAIN_TILE_GRASS_0_1010 },
-//                 { "0-1011", TextureID::TERRAIN_TILE_GRASS_0_1011 },
-//                 { "0-1100", TextureID::TERRAIN_TILE_GRASS_0_1100 },
-//                 { "0-1101", TextureID::TERRAIN_TILE_GRASS_0_1101 },
-//                 { "0-1110", TextureID::TERRAIN_TILE_GRASS_0_1110 },
-//                 { "0-1111", TextureID::TERRAIN_TILE_GRASS_0_1111 },
-//                 
-//                 { "1-0000", TextureID::TERRAIN_TILE_GRASS_1_0000 },
-//                 { "1-0001", TextureID::TERRAIN_TILE_GRASS_1_0001 },
-//                 { "1-0010", TextureID::TERRAIN_TILE_GRASS_1_0010 },
-//                 { "1-0011", TextureID::TERRAIN_TILE_GRASS_1_0011 },
-//                 { "1-0100", TextureID::TERRAIN_TILE_GRASS_1_0100 },
-//                 { "1-0101", TextureID::TERRAIN_TILE_GRASS_1_0101 },
-//                 { "1-0110", TextureID::TERRAIN_TILE_GRASS_1_0110 },
-//                 { "1-0111", TextureID::TERRAIN_TILE_GRASS_1_0111 },
-//                 { "1-1000", TextureID::TERRAIN_TILE_GRASS_1_1000 },
-//                 { "1-1001", TextureID::TERRAIN_TILE_GRASS_1_1001 },
-//                 { "1-1010", TextureID::TERRAIN_TILE_GRASS_1_1010 },
-//                 { "1-1011", TextureID::TERRAIN_TILE_GRASS_1_1011 },
-//                 { "1-1100", TextureID::TERRAIN_TILE_GRASS_1_1100 },
-//                 { "1-1101", TextureID::TERRAIN_TILE_GRASS_1_1101 },
-//                 { "1-1110", TextureID::TERRAIN_TILE_GRASS_1_1110 },
-//                 { "1-1111", TextureID::TERRAIN_TILE_GRASS_1_1111 }
-                
-                { "0-0-0000", TextureID::INVALID },
-                { "0-0-0001", TextureID::INVALID },
-                { "0-0-0010", TextureID::INVALID },
-                { "0-0-0011", TextureID::INVALID },
-                { "0-0-0100", TextureID::INVALID },
-                { "0-0-0101", TextureID::INVALID },
-                { "0-0-0110", TextureID::INVALID },
-                { "0-0-0111", TextureID::INVALID },
-                { "0-0-1000", TextureID::INVALID },
-                { "0-0-1001", TextureID::INVALID },
-                { "0-0-1010", TextureID::INVALID },
-                { "0-0-1011", TextureID::INVALID },
-                { "0-0-1100", TextureID::INVALID },
-                { "0-0-1101", TextureID::INVALID },
-                { "0-0-1110", TextureID::INVALID },
-                { "0-0-1111", TextureID::INVALID },
-                
-                { "0-1-0000", TextureID::INVALID },
-                { "0-1-0001", TextureID::INVALID },
-                { "0-1-0010", TextureID::INVALID },
-                { "0-1-0011", TextureID::INVALID },
-                { "0-1-0100", TextureID::INVALID },
-                { "0-1-0101", TextureID::INVALID },
-                { "0-1-0110", TextureID::INVALID },
-                { "0-1-0111", TextureID::INVALID },
-                { "0-1-1000", TextureID::INVALID },
-                { "0-1-1001", TextureID::INVALID },
-                { "0-1-1010", TextureID::INVALID },
-                { "0-1-1011", TextureID::INVALID },
-                { "0-1-1100", TextureID::INVALID },
-                { "0-1-1101", TextureID::INVALID },
-                { "0-1-1110", TextureID::INVALID },
-                { "0-1-1111", TextureID::INVALID },
-                
-//                 { "0-0-0000", TextureID::TERRAIN_TILE_GRASS_0_0000 },
-//                 { "0-0-0001", TextureID::TERRAIN_TILE_GRASS_0_0001 },
-//                 { "0-0-0010", TextureID::TERRAIN_TILE_GRASS_0_0010 },
-//                 { "0-0-0011", TextureID::TERRAIN_TILE_GRASS_0_0011 },
-//                 { "0-0-0100", TextureID::TERRAIN_TILE_GRASS_0_0100 },
-//                 { "0-0-0101", TextureID::TERRAIN_TILE_GRASS_0_0101 },
-//                 { "0-0-0110", TextureID::TERRAIN_TILE_GRASS_0_0110 },
-//                 { "0-0-0111", TextureID::TERRAIN_TILE_GRASS_0_0111 },
-//                 { "0-0-1000", TextureID::TERRAIN_TILE_GRASS_0_1000 },
-//                 { "0-0-1001", TextureID::TERRAIN_TILE_GRASS_0_1001 },
-//                 { "0-0-1010", TextureID::TERRAIN_TILE_GRASS_0_1010 },
-//                 { "0-0-1011", TextureID::TERRAIN_TILE_GRASS_0_1011 },
-//                 { "0-0-1100", TextureID::TERRAIN_TILE_GRASS_0_1100 },
-//                 { "0-0-1101", TextureID::TERRAIN_TILE_GRASS_0_1101 },
-//                 { "0-0-1110", TextureID::TERRAIN_TILE_GRASS_0_1110 },
-//                 { "0-0-1111", TextureID::TERRAIN_TILE_GRASS_0_1111 },
-//                 
-//                 { "0-1-0000", TextureID::TERRAIN_TILE_GRASS_1_0000 },
-//                 { "0-1-0001", TextureID::TERRAIN_TILE_GRASS_1_0001 },
-//                 { "0-1-0010", TextureID::TERRAIN_TILE_GRASS_1_0010 },
-//                 { "0-1-0011", TextureID::TERRAIN_TILE_GRASS_1_0011 },
-//                 { "0-1-0100", TextureID::TERRAIN_TILE_GRASS_1_0100 },
-//                 { "0-1-0101", TextureID::TERRAIN_TILE_GRASS_1_0101 },
-//                 { "0-1-0110", TextureID::TERRAIN_TILE_GRASS_1_0110 },
-//                 { "0-1-0111", TextureID::TERRAIN_TILE_GRASS_1_0111 },
-//                 { "0-1-1000", TextureID::TERRAIN_TILE_GRASS_1_1000 },
-//                 { "0-1-1001", TextureID::TERRAIN_TILE_GRASS_1_1001 },
-//                 { "0-1-1010", TextureID::TERRAIN_TILE_GRASS_1_1010 },
-//                 { "0-1-1011", TextureID::TERRAIN_TILE_GRASS_1_1011 },
-//                 { "0-1-1100", TextureID::TERRAIN_TILE_GRASS_1_1100 },
-//                 { "0-1-1101", TextureID::TERRAIN_TILE_GRASS_1_1101 },
-//                 { "0-1-1110", TextureID::TERRAIN_TILE_GRASS_1_1110 },
-//                 { "0-1-1111", TextureID::TERRAIN_TILE_GRASS_1_1111 },
-                
-                { "1-0-0000", TextureID::TERRAIN_TILE_GRASS_0_0000 },
-                { "1-0-0001", TextureID::TERRAIN_TILE_GRASS_0_0001 },
-                { "1-0-0010", TextureID::TERRAIN_TILE_GRASS_0_0010 },
-                { "1-0-0011", TextureID::TERRAIN_TILE_GRASS_0_0011 },
-                { "1-0-0100", TextureID::TERRAIN_TILE_GRASS_0_0100 },
-                { "1-0-0101", TextureID::TERRAIN_TILE_GRASS_0_0101 },
-                { "1-0-0110", TextureID::TERRAIN_TILE_GRASS_0_0110 },
-                { "1-0-0111", TextureID::TERRAIN_TILE_GRASS_0_0111 },
-                { "1-0-1000", TextureID::TERRAIN_TILE_GRASS_0_1000 },
-                { "1-0-1001", TextureID::TERRAIN_TILE_GRASS_0_1001 },
-                { "1-0-1010", TextureID::TERRAIN_TILE_GRASS_0_1010 },
-                { "1-0-1011", TextureID::TERRAIN_TILE_GRASS_0_1011 },
-                { "1-0-1100", TextureID::TERRAIN_TILE_GRASS_0_1100 },
-                { "1-0-1101", TextureID::TERRAIN_TILE_GRASS_0_1101 },
-                { "1-0-1110", TextureID::TERRAIN_TILE_GRASS_0_1110 },
-                { "1-0-1111", TextureID::TERRAIN_TILE_GRASS_0_1111 },
-                
-                { "1-1-0000", TextureID::TERRAIN_TILE_GRASS_1_0000 },
-                { "1-1-0001", TextureID::TERRAIN_TILE_GRASS_1_0001 },
-                { "1-1-0010", TextureID::TERRAIN_TILE_GRASS_1_0010 },
-                { "1-1-0011", TextureID::TERRAIN_TILE_GRASS_1_0011 },
-                { "1-1-0100", TextureID::TERRAIN_TILE_GRASS_1_0100 },
-                { "1-1-0101", TextureID::TERRAIN_TILE_GRASS_1_0101 },
-                { "1-1-0110", TextureID::TERRAIN_TILE_GRASS_1_0110 },
-                { "1-1-0111", TextureID::TERRAIN_TILE_GRASS_1_0111 },
-                { "1-1-1000", TextureID::TERRAIN_TILE_GRASS_1_1000 },
-                { "1-1-1001", TextureID::TERRAIN_TILE_GRASS_1_1001 },
-                { "1-1-1010", TextureID::TERRAIN_TILE_GRASS_1_1010 },
-                { "1-1-1011", TextureID::TERRAIN_TILE_GRASS_1_1011 },
-                { "1-1-1100", TextureID::TERRAIN_TILE_GRASS_1_1100 },
-                { "1-1-1101", TextureID::TERRAIN_TILE_GRASS_1_1101 },
-                { "1-1-1110", TextureID::TERRAIN_TILE_GRASS_1_1110 },
-                { "1-1-1111", TextureID::TERRAIN_TILE_GRASS_1_1111 },//,
-                
-                { "2-0-0000", TextureID::TERRAIN_TILE_DESERT_0_0000 },
-                { "2-0-0001", TextureID::TERRAIN_TILE_DESERT_0_0001 },
-                { "2-0-0010", TextureID::TERRAIN_TILE_DESERT_0_0010 },
-                { "2-0-0011", TextureID::TERRAIN_TILE_DESERT_0_0011 },
-                { "2-0-0100", TextureID::TERRAIN_TILE_DESERT_0_0100 },
-                { "2-0-0101", TextureID::TERRAIN_TILE_DESERT_0_0101 },
-                { "2-0-0110", TextureID::TERRAIN_TILE_DESERT_0_0110 },
-                { "2-0-0111", TextureID::TERRAIN_TILE_DESERT_0_0111 },
-                { "2-0-1000", TextureID::TERRAIN_TILE_DESERT_0_1000 },
-                { "2-0-1001", TextureID::TERRAIN_TILE_DESERT_0_1001 },
-                { "2-0-1010", TextureID::TERRAIN_TILE_DESERT_0_1010 },
-                { "2-0-1011", TextureID::TERRAIN_TILE_DESERT_0_1011 },
-                { "2-0-1100", TextureID::TERRAIN_TILE_DESERT_0_1100 },
-                { "2-0-1101", TextureID::TERRAIN_TILE_DESERT_0_1101 },
-                { "2-0-1110", TextureID::TERRAIN_TILE_DESERT_0_1110 },
-                { "2-0-1111", TextureID::TERRAIN_TILE_DESERT_0_1111 },
-                
-                { "2-1-0000", TextureID::TERRAIN_TILE_DESERT_1_0000 },
-                { "2-1-0001", TextureID::TERRAIN_TILE_DESERT_1_0001 },
-                { "2-1-0010", TextureID::TERRAIN_TILE_DESERT_1_0010 },
-                { "2-1-0011", TextureID::TERRAIN_TILE_DESERT_1_0011 },
-                { "2-1-0100", TextureID::TERRAIN_TILE_DESERT_1_0100 },
-                { "2-1-0101", TextureID::TERRAIN_TILE_DESERT_1_0101 },
-                { "2-1-0110", TextureID::TERRAIN_TILE_DESERT_1_0110 },
-                { "2-1-0111", TextureID::TERRAIN_TILE_DESERT_1_0111 },
-                { "2-1-1000", TextureID::TERRAIN_TILE_DESERT_1_1000 },
-                { "2-1-1001", TextureID::TERRAIN_TILE_DESERT_1_1001 },
-                { "2-1-1010", TextureID::TERRAIN_TILE_DESERT_1_1010 },
-                { "2-1-1011", TextureID::TERRAIN_TILE_DESERT_1_1011 },
-                { "2-1-1100", TextureID::TERRAIN_TILE_DESERT_1_1100 },
-                { "2-1-1101", TextureID::TERRAIN_TILE_DESERT_1_1101 },
-                { "2-1-1110", TextureID::TERRAIN_TILE_DESERT_1_1110 },
-                { "2-1-1111", TextureID::TERRAIN_TILE_DESERT_1_1111 },
-                
-                { "3-0-0000", TextureID::TERRAIN_TILE_SNOW_0_0000 },
-                { "3-0-0001", TextureID::TERRAIN_TILE_SNOW_0_0001 },
-                { "3-0-0010", TextureID::TERRAIN_TILE_SNOW_0_0010 },
-                { "3-0-0011", TextureID::TERRAIN_TILE_SNOW_0_0011 },
-                { "3-0-0100", TextureID::TERRAIN_TILE_SNOW_0_0100 },
-                { "3-0-0101", TextureID::TERRAIN_TILE_SNOW_0_0101 },
-                { "3-0-0110", TextureID::TERRAIN_TILE_SNOW_0_0110 },
-                { "3-0-0111", TextureID::TERRAIN_TILE_SNOW_0_0111 },
-                { "3-0-1000", TextureID::TERRAIN_TILE_SNOW_0_1000 },
-                { "3-0-1001", TextureID::TERRAIN_TILE_SNOW_0_1001 },
-                { "3-0-1010", TextureID::TERRAIN_TILE_SNOW_0_1010 },
-                { "3-0-1011", TextureID::TERRAIN_TILE_SNOW_0_1011 },
-                { "3-0-1100", TextureID::TERRAIN_TILE_SNOW_0_1100 },
-                { "3-0-1101", TextureID::TERRAIN_TILE_SNOW_0_1101 },
-                { "3-0-1110", TextureID::TERRAIN_TILE_SNOW_0_1110 },
-                { "3-0-1111", TextureID::TERRAIN_TILE_SNOW_0_1111 },
-                
-                { "3-1-0000", TextureID::TERRAIN_TILE_SNOW_1_0000 },
-                { "3-1-0001", TextureID::TERRAIN_TILE_SNOW_1_0001 },
-                { "3-1-0010", TextureID::TERRAIN_TILE_SNOW_1_0010 },
-                { "3-1-0011", TextureID::TERRAIN_TILE_SNOW_1_0011 },
-                { "3-1-0100", TextureID::TERRAIN_TILE_SNOW_1_0100 },
-                { "3-1-0101", TextureID::TERRAIN_TILE_SNOW_1_0101 },
-                { "3-1-0110", TextureID::TERRAIN_TILE_SNOW_1_0110 },
-                { "3-1-0111", TextureID::TERRAIN_TILE_SNOW_1_0111 },
-                { "3-1-1000", TextureID::TERRAIN_TILE_SNOW_1_1000 },
-                { "3-1-1001", TextureID::TERRAIN_TILE_SNOW_1_1001 },
-                { "3-1-1010", TextureID::TERRAIN_TILE_SNOW_1_1010 },
-                { "3-1-1011", TextureID::TERRAIN_TILE_SNOW_1_1011 },
-                { "3-1-1100", TextureID::TERRAIN_TILE_SNOW_1_1100 },
-                { "3-1-1101", TextureID::TERRAIN_TILE_SNOW_1_1101 },
-                { "3-1-1110", TextureID::TERRAIN_TILE_SNOW_1_1110 },
-                { "3-1-1111", TextureID::TERRAIN_TILE_SNOW_1_1111 }
+                TextureID m_textures[TERRAIN_COUNT][2][16];
             };
             
-            auto it = m_overlayMap.find( id );
-            if ( it != m_overlayMap.end() )
+            // The transitions of a terrain are declared in TextureID as the 16
+            // straight ones followed by the 16 diagonal ones, in the order of
+            // their masks, so the table is filled in from the first of each.
+            // The empty masks and the lowest terrain (water) have no overlays.
+            constexpr OverlayTable makeOverlayTable()
             {
-                return it->second;
-            }
-            
-            //std::cout << id << " : INVALID!!!!\n";
-            return TextureID::INVALID;
-        }        
-        
-        Tile::Tile() //:
-//          m_tileQuad{ sf::Quads, 4 },
-//          m_overlayQuad{ sf::Quads, 4 }
-        {
-            // Create the tile vertex array
-            m_tileQuad.setPrimitiveType( sf::Quads );
-            m_tileQuad.append( sf::Vertex() );
-            m_tileQuad.append( sf::Vertex() );
-            m_tileQuad.append( sf::Vertex() );
-            m_tileQuad.append( sf::Vertex() );
-            
-//             // Create the straight overlay vertex array
-//             m_overlayQuad[0].setPrimitiveType( sf::Quads );
-//             m_overlayQuad[0].append( sf::Vertex() );
-//             m_overlayQuad[0].append( sf::Vertex() );
-//             m_overlayQuad[0].append( sf::Vertex() );
-//             m_overlayQuad[0].append( sf::Vertex() );
-//             
-//             // Create the diagonal overlay vertex array
-//             m_overlayQuad[1].setPrimitiveType( sf::Quads );
-//             m_overlayQuad[1].append( sf::Vertex() );
-//             m_overlayQuad[1].append( sf::Vertex() );
-//             m_overlayQuad[1].append( sf::Vertex() );
-//             m_overlayQuad[1].append( sf::Vertex() );
-            
-            for ( int i = 0; i < TERRAIN_COUNT - 1; ++i )
-                for ( int j = 0; j < 2; ++j )
+                const TextureID first[TERRAIN_COUNT] =
                 {
-                    m_overlayQuad[i][j].setPrimitiveType( sf::Quads );
-                    m_overlayQuad[i][j].append( sf::Vertex() );
-                    m_overlayQuad[i][j].append( sf::Vertex() );
-                    m_overlayQuad[i][j].append( sf::Vertex() );
-                    m_overlayQuad[i][j].append( sf::Vertex() );
-                }
-            
-            // Initialize the tile and overlays vertex arrays
-            
-            m_tileQuad[0].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, 0.f };
-            m_tileQuad[1].texCoords = sf::Vector2f{ TERRAIN_TILE_WIDTH, TERRAIN_TILE_HEIGHT * 0.5 };
-            m_tileQuad[2].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, TERRAIN_TILE_HEIGHT };
-            m_tileQuad[3].texCoords = sf::Vector2f{ 0.f, TERRAIN_TILE_HEIGHT * 0.5 };
-            
-//             m_overlayQuad[0][0].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, 0.f };
-//             m_overlayQuad[0][1].texCoords = sf::Vector2f{ TERRAIN_TILE_WIDTH, TERRAIN_TILE_HEIGHT * 0.5 };
-//             m_overlayQuad[0][2].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, TERRAIN_TILE_HEIGHT };
-//             m_overlayQuad[0][3].texCoords = sf::Vector2f{ 0.f, TERRAIN_TILE_HEIGHT * 0.5 };
-//             
-//             m_overlayQuad[1][0].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, 0.f };
-//             m_overlayQuad[1][1].texCoords = sf::Vector2f{ TERRAIN_TILE_WIDTH, TERRAIN_TILE_HEIGHT * 0.5 };
-//             m_overlayQuad[1][2].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, TERRAIN_TILE_HEIGHT };
-//             m_overlayQuad[1][3].texCoords = sf::Vector2f{ 0.f, TERRAIN_TILE_HEIGHT * 0.5 };
-            
-            for ( int i = 0; i < TERRAIN_COUNT - 1; ++i )
-                for ( int j = 0; j < 2; ++j )
-                {
-                    m_overlayQuad[i][j][0].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, 0.f };
-                    m_overlayQuad[i][j][1].texCoords = sf::Vector2f{ TERRAIN_TILE_WIDTH, TERRAIN_TILE_HEIGHT * 0.5 };
-                    m_overlayQuad[i][j][2].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, TERRAIN_TILE_HEIGHT };
-                    m_overlayQuad[i][j][3].texCoords = sf::Vector2f{ 0.f, TERRAIN_TILE_HEIGHT * 0.5 };
-                    
-                    m_overlayTexPtr[i][j] = nullptr;
-                }
-            
-//             m_overlayTexPtr[0] = nullptr;
-//             m_overlayTexPtr[1] = nullptr;
-            
-            setPosition( sf::Vector2f{ 0.f, 0.f} );
+                    TextureID::INVALID,
+                    TextureID::TERRAIN_TILE_GRASS_0_0000,
+                    TextureID::TERRAIN_TILE_DESERT_0_0000,
+                    TextureID::TERRAIN_TILE_SNOW_0_0000
+                };
+                
+                OverlayTable table{};
+                
+                for ( int prec = 0; prec < TERRAIN_COUNT; ++prec )
+                    for ( int overlay = 0; overlay < 2; ++overlay )
+                        for ( int mask = 0; mask < 16; ++mask )
+                        {
+                            if ( first[prec] == TextureID::INVALID || mask == 0 )
+                                table.m_textures[prec][overlay][mask] = TextureID::INVALID;
+                            else
+                                table.m_textures[prec][overlay][mask] = static_cast<TextureID>( static_cast<int>( first[prec] ) + overlay * 16 + mask );
+                        }
+                
+                return table;
+            }
             
-            TextureID texture = TextureID::TERRAIN_TILE_WATER_01;
+            constexpr OverlayTable OVERLAY_TABLE = makeOverlayTable();
             
-            m_tileTexPtr = ResourceManager::getTexture( texture ).get();
-            if ( !m_tileTexPtr )
-                LOG(Logger::Level::ERROR) << "Unable to load tile texture: " << textureIDToStr( texture ) << std::endl;
+            static_assert( static_cast<int>( TextureID::TERRAIN_TILE_GRASS_1_1111 ) - static_cast<int>( TextureID::TERRAIN_TILE_GRASS_0_0000 ) == 31 &&
+                           static_cast<int>( TextureID::TERRAIN_TILE_DESERT_1_1111 ) - static_cast<int>( TextureID::TERRAIN_TILE_DESERT_0_0000 ) == 31 &&
+                           static_cast<int>( TextureID::TERRAIN_TILE_SNOW_1_1111 ) - static_cast<int>( TextureID::TERRAIN_TILE_SNOW_0_0000 ) == 31,
+                           "The transition textures of a terrain must be declared contiguously" );
             
-            // Attach an animation to the tile
-            if ( isAnimatedTexture( texture ) )
+            // { x-offset, y-offset } of the neighbors of a tile, with the
+            // index of each being its bit in the neighbor masks
+            const int stNeighbors[4][2] =
             {
-                AnimationManager::AnimationManager::createAnimation( "tile-anim-" + std::to_string( long(getQuad()) ), &m_tileQuad, sf::Vector2i{ 128, 64 }, 2, sf::seconds(1.5f) );
-                setAnimated(true);
-            }
-            else
-                setAnimated(false);
-            
-            // By default each tile created is assumed to be in the camera view
-            m_inView = false;
-            
-            m_type = getTerrainType( texture );
+                {  0, -1 }, // N
+                {  1,  0 }, // E
+                {  0,  1 }, // S
+                { -1,  0 }  // W
+            };
             
-            //m_neighborsStraight.set(false);
-            //m_neighborsDiagonal.set(false);
-            for ( int i = 0; i < TERRAIN_COUNT - 1; ++i )
+            const int diaNeighbors[4][2] =
             {
-                m_neighborsStraight[i] = 0x00;
-                m_neighborsDiagonal[i] = 0x00;
-            }
+                {  1, -1 }, // NE
+                {  1,  1 }, // SE
+                { -1,  1 }, // SW
+                { -1, -1 }  // NW
+            };
         }
         
-        Tile::~Tile()
+        int Tile::precedence( const TerrainType type )
         {
-            if ( tileAnimated() )
-                AnimationManager::AnimationManager::destroyAnimation( "tile-anim-" + std::to_string( long(getQuad()) ) );
-        }
-
-        void Tile::setPosition( const sf::Vector2f position )
-        {
-            m_tileQuad[0].position = position;
-            m_tileQuad[1].position = sf::Vector2f{ m_tileQuad[0].position.x + TERRAIN_TILE_HEIGHT, m_tileQuad[0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
-            m_tileQuad[2].position = sf::Vector2f{ m_tileQuad[0].position.x, m_tileQuad[0].position.y + TERRAIN_TILE_HEIGHT };
-            m_tileQuad[3].position = sf::Vector2f{ m_tileQuad[0].position.x - TERRAIN_TILE_HEIGHT, m_tileQuad[0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
-            
-//             m_overlayQuad[0][0].position = position;
-//             m_overlayQuad[0][1].position = sf::Vector2f{ m_overlayQuad[0][0].position.x + TERRAIN_TILE_HEIGHT, m_overlayQuad[0][0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
-//             m_overlayQuad[0][2].position = sf::Vector2f{ m_overlayQuad[0][0].position.x, m_overlayQuad[0][0].position.y + TERRAIN_TILE_HEIGHT };
-//             m_overlayQuad[0][3].position = sf::Vector2f{ m_overlayQuad[0][0].position.x - TERRAIN_TILE_HEIGHT, m_overlayQuad[0][0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
-//             
-//             m_overlayQuad[1][0].position = position;
-//             m_overlayQuad[1][1].position = sf::Vector2f{ m_overlayQuad[1][0].position.x + TERRAIN_TILE_HEIGHT, m_overlayQuad[1][0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
-//             m_overlayQuad[1][2].position = sf::Vector2f{ m_overlayQuad[1][0].position.x, m_overlayQuad[1][0].position.y + TERRAIN_TILE_HEIGHT };
-//             m_overlayQuad[1][3].position = sf::Vector2f{ m_overlayQuad[1][0].position.x - TERRAIN_TILE_HEIGHT, m_overlayQuad[1][0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
+            // Indexed by TerrainType
+            static constexpr int precedences[] =
+            {
+                0, // WATER
+                1, // GRASS
+                2, // DESERT
+                3  // SNOW
+            };
             
-            for ( int i = 0; i < TERRAIN_COUNT - 1; ++i )
-                for ( int j = 0; j < 2; ++j )
-                {
-                    m_overlayQuad[i][j][0].position = position;
-                    m_overlayQuad[i][j][1].position = sf::Vector2f{ m_overlayQuad[i][j][0].position.x + TERRAIN_TILE_HEIGHT, m_overlayQuad[i][j][0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
-                    m_overlayQuad[i][j][2].position = sf::Vector2f{ m_overlayQuad[i][j][0].position.x, m_overlayQuad[i][j][0].position.y + TERRAIN_TILE_HEIGHT };
-                    m_overlayQuad[i][j][3].position = sf::Vector2f{ m_overlayQuad[i][j][0].position.x - TERRAIN_TILE_HEIGHT, m_overlayQuad[i][j][0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
-                }
+            return type < TerrainType::NON_TERRAIN_TEXTURE ? precedences[static_cast<int>( type )] : 0;
         }
-
-        const sf::Vector2f Tile::getPosition( int vertex )
+        
+        TextureID Tile::getOverlayTexture( const int terrainPrec, const int overlay, const NeighborMask mask )
         {
-            if ( vertex < 0 || vertex > 3 )
-            {
-                LOG(Logger::Level::ERROR) << "Vertex must be an integer between 0 and 4." << std::endl;
-                return sf::Vector2f{ UINT16_MAX, UINT16_MAX }; // Indicates invalid tile
-            }
-            
-            return m_tileQuad[vertex].position;
+            return OVERLAY_TABLE.m_textures[terrainPrec][overlay][mask & 0x0F];
         }
-
-        void Tile::setFillColor( const sf::Color fillColor )
-        {
-            m_tileQuad[0].color = fillColor;
-            m_tileQuad[1].color = fillColor;
-            m_tileQuad[2].color = fillColor;
-            m_tileQuad[3].color = fillColor;
-            
-//             m_overlayQuad[0][0].color = fillColor;
-//             m_overlayQuad[0][1].color = fillColor;
-//             m_overlayQuad[0][2].color = fillColor;
-//             m_overlayQuad[0][3].color = fillColor;
-//             
-//             m_overlayQuad[1][0].color = fillColor;
-//             m_overlayQuad[1][1].color = fillColor;
-//             m_overlayQuad[1][2].color = fillColor;
-//             m_overlayQuad[1][3].color = fillColor;
+        
+        Tile::Tile() :
+         m_texture( TextureID::TERRAIN_TILE_WATER_01 ),
+         m_type( getTerrainType( TextureID::TERRAIN_TILE_WATER_01 ) ),
+         m_flags( 0 )
+        {
+            setAnimated( isAnimatedTexture( m_texture ) );
             
             for ( int i = 0; i < TERRAIN_COUNT - 1; ++i )
                 for ( int j = 0; j < 2; ++j )
-                {
-                    m_overlayQuad[i][j][0].color = fillColor;
-                    m_overlayQuad[i][j][1].color = fillColor;
-                    m_overlayQuad[i][j][2].color = fillColor;
-                    m_overlayQuad[i][j][3].color = fillColor;
-                }
-        }
-
-        // https://stackoverflow.com/questions/27100729/find-which-tile-was-clicked-in-a-isometric-staggered-column-system
-        bool Tile::contains( const sf::Vector2f mouse )
-        {
-            sf::Vector2f center{ m_tileQuad[3].position.x + TERRAIN_TILE_WIDTH * 0.5f, m_tileQuad[0].position.y + TERRAIN_TILE_HEIGHT * 0.5f };
-            float dx = std::abs( mouse.x - center.x );
-            float dy = std::abs( mouse.y - center.y );
-            
-            return dx / ( TERRAIN_TILE_WIDTH * 0.5f - 1.f) + dy / ( TERRAIN_TILE_HEIGHT * 0.5f - 1.f ) < 1;
+                    m_overlays[i][j] = TextureID::INVALID;
         }
-
+        
         void Tile::setTexture( const TextureID texID )
         {
-            m_tileTexPtr = ResourceManager::getTexture( texID ).get();
-            if ( !m_tileTexPtr )
-                LOG(Logger::Level::ERROR) << "Unable to load tile texture: " << textureIDToStr( texID ) << std::endl;
+            m_texture = texID;
         }
         
-        bool Tile::inWorldView( const sf::View worldView ) const
+        TextureID Tile::getTexture() const
         {
-            //return m_inView;
-            float viewLeft  = worldView.getCenter().x - worldView.getSize().x * 0.5f - TERRAIN_TILE_WIDTH;
-            float viewTop   = worldView.getCenter().y - worldView.getSize().y * 0.5f - TERRAIN_TILE_HEIGHT;
-            float viewRight = worldView.getCenter().x + worldView.getSize().x * 0.5f + TERRAIN_TILE_WIDTH;
-            float viewDown  = worldView.getCenter().y + worldView.getSize().y * 0.5f + TERRAIN_TILE_HEIGHT;
-            
-            return m_tileQuad[0].position.y >= viewTop && m_tileQuad[0].position.y <= viewDown &&
-                    m_tileQuad[2].position.y >= viewTop && m_tileQuad[2].position.y <= viewDown &&
-                     m_tileQuad[1].position.x >= viewLeft && m_tileQuad[1].position.x <= viewRight &&
-                      m_tileQuad[3].position.x >= viewLeft && m_tileQuad[3].position.x <= viewRight;
+            return m_texture;
         }
         
         void Tile::setAnimated( bool animated )
         {
-            m_animated = animated;
-            
-            m_tileQuad[0].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, 0.f };
-            m_tileQuad[1].texCoords = sf::Vector2f{ TERRAIN_TILE_WIDTH, TERRAIN_TILE_HEIGHT * 0.5f };
-            m_tileQuad[2].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, TERRAIN_TILE_HEIGHT };
-            m_tileQuad[3].texCoords = sf::Vector2f{ 0.f, TERRAIN_TILE_HEIGHT * 0.5f };
+            if ( animated )
+                m_flags |= ANIMATED;
+            else
+                m_flags &= ~ANIMATED;
         }
         
         bool Tile::tileAnimated() const
         {
-            return m_animated;
-        }
-        
-        sf::VertexArray* Tile::getQuad()
-        {
-            return &m_tileQuad;
+            return m_flags & ANIMATED;
         }
         
         void Tile::setType( TerrainType terrainType )
@@ -481,499 +155,601 @@ namespace rts
             m_type = terrainType;
         }
                 
-        TerrainType Tile::getType()
+        TerrainType Tile::getType() const
         {
             return m_type;
         }
         
         void Tile::setOverlayTexture( const int terrainPrec, const int overlay, TextureID texID )
         {
-            //std::cout << "XX " << terrainPrec << ", " << overlay << ", " << textureIDToStr( texID ) << std::endl;
-            if ( texID == TextureID::INVALID || texID == getOverlayTexture( "1-0-0000" ) || texID == getOverlayTexture( "1-1-0000" ) || texID == getOverlayTexture( "2-0-0000" ) || texID == getOverlayTexture( "2-1-0000" ) || texID == getOverlayTexture( "3-0-0000" ) || texID == getOverlayTexture( "3-1-0000" ) )
-                m_overlayTexPtr[terrainPrec][overlay] = nullptr;
-            else
-                m_overlayTexPtr[terrainPrec][overlay] = ResourceManager::getTexture( texID ).get();
-        }
-
-        void Tile::draw(sf::RenderTarget& target, sf::RenderStates states) const
-        {
-            states.transform *= getTransform();
-            states.texture = m_tileTexPtr;
-            target.draw( m_tileQuad, states);
-            
-//             if ( m_overlayTexPtr[0] != nullptr )
-//             {
-//                 states.texture = m_overlayTexPtr[0];
-//                 target.draw( m_overlayQuad[0], states);
-//             }
-//             
-//             if ( m_overlayTexPtr[1] != nullptr )
-//             {
-//                 states.texture = m_overlayTexPtr[1];
-//                 target.draw( m_overlayQuad[1], states);
-//             }
-            
-            for ( int i = 0; i < TERRAIN_COUNT - 1; ++i )
-                for ( int j = 0; j < 2; ++j )
-                {
-                    if ( m_overlayTexPtr[i][j] != nullptr )
-                    {
-                        if ( m_precedences[m_type] - 1 < i )
-                        {
-                            states.texture = m_overlayTexPtr[i][j];
-                            target.draw( m_overlayQuad[i][j], states);
-                        }
-                    }
-                }
+            m_overlays[terrainPrec][overlay] = texID;
         }
         
         ///////////////////////////////////////////////////////////////////////////////////////////
         
         TileMap::TileMap( const int size, sf::RenderWindow& window ) :
          m_size( size ),
+         m_gridPos( window.getSize().x / 2.f, 0.f ),
+         m_tiles( size * size ),
+         m_input{ false, sf::Vector2i(), sf::Vector2f(), false },
          m_selectedTile( TextureID::TERRAIN_TILE_WATER_01 ),
+         m_camera( sf::Vector2f{ WINDOW_WIDTH, WINDOW_HEIGHT }, sf::Vector2f{ WINDOW_WIDTH / 2.f, size * TERRAIN_TILE_HEIGHT * 0.5f } ),
+         m_renderTiles( size * size ),
+         m_chunkCount( ( size + TILE_CHUNK_SIZE - 1 ) / TILE_CHUNK_SIZE ),
+         m_frame( 0 ),
+         m_animationOffset( 0.f ),
+         m_regions( static_cast<int>( TextureID::MAX_TEXTURES ) ),
+         m_hoveredTile( -1, -1 ),
+         m_hoverQuad( sf::Quads, 4 ),
          m_window( &window )
         {
             LOG(Logger::Level::INFO) << "Creating TileMap..." << std::endl;
             
-            // Create a sizexsize 2D grid of tiles
-            //m_tiles.resize( m_size, std::vector<Tile>( m_size, Tile() ) );
-            for ( int y = 0; y < m_size; ++y )
+            // Cache the atlas regions of the textures used by the tiles,
+            // so that building chunks does not query the ResourceManager
+            for ( int t = 0; t < static_cast<int>( TextureID::MAX_TEXTURES ); ++t )
             {
-                m_tiles.push_back( std::vector<Tile::Ptr>() );
-                for ( int x = 0; x < m_size; ++x )
-                    m_tiles[y].push_back( std::make_shared<Tile>() );
+                if ( getTerrainType( static_cast<TextureID>( t ) ) == TerrainType::NON_TERRAIN_TEXTURE )
+                    continue;
+                
+                m_regions[t] = ResourceManager::getAtlasRegion( static_cast<TextureID>( t ) );
+                if ( !m_regions[t].m_texture )
+                    LOG(Logger::Level::ERROR) << "Unable to load tile texture: " << textureIDToStr( static_cast<TextureID>( t ) ) << std::endl;
             }
             
-            // Position of tile (0,0)
-            const sf::Vector2f gridPos{ window.getSize().x / 2.f, 0.f };
+            // All animated tiles share one lazy animation, whose
+            // frame is read only for the chunks in view
+            m_animation = AnimationManager::AnimationManager::createAnimation( AnimationManager::AnimationManager::getClip( "water-tile" ), "tile-anim" );
+            
+            // Split the map into chunks, their vertex arrays
+            // are built as they come into view
+            m_chunks.resize( m_chunkCount * m_chunkCount );
+            
+            // Keep the view over the quads of the map, the bounds
+            // only change with the size of the map
+            float left   = tilePosition( 0, m_size - 1 ).x - TERRAIN_TILE_HEIGHT;
+            float right  = tilePosition( m_size - 1, 0 ).x + TERRAIN_TILE_HEIGHT;
+            float top    = tilePosition( 0, 0 ).y;
+            float bottom = tilePosition( m_size - 1, m_size - 1 ).y + TERRAIN_TILE_HEIGHT;
+            
+            m_camera.setBounds( sf::FloatRect{ left, top, right - left, bottom - top } );
+            m_camera.apply( window );
+            
+            // Something to draw before the first update
+            m_snapshots.back().m_view = m_camera.getView();
+            m_snapshots.back().m_previousCenter = m_camera.getView().getCenter();
+            m_snapshots.back().m_hoveredTile = sf::Vector2i{ -1, -1 };
+            m_snapshots.publish();
+            
+            LOG(Logger::Level::INFO) << "TileMap successfully created (" << m_chunks.size() << " chunks)" << std::endl;
+        }
+        
+        TileMap::~TileMap()
+        {
+            AnimationManager::AnimationManager::destroyAnimation( m_animation );
+            AnimationManager::AnimationManager::resetViewRect();
+            LOG(Logger::Level::INFO) << "TileMap destroyed." << std::endl;
+        }
+        
+        Tile& TileMap::tile( const int x, const int y )
+        {
+            return m_tiles[y * m_size + x];
+        }
+        
+        const Tile& TileMap::tile( const int x, const int y ) const
+        {
+            return m_tiles[y * m_size + x];
+        }
+        
+        const Tile& TileMap::renderTile( const int x, const int y ) const
+        {
+            return m_renderTiles[y * m_size + x];
+        }
+        
+        sf::Vector2f TileMap::tilePosition( const int x, const int y ) const
+        {
+            float cX = (TERRAIN_TILE_HEIGHT - 1.5) * x;
+            float cY = (TERRAIN_TILE_HEIGHT - 1.5) * y;
+            
+            return sf::Vector2f{ cX - cY + m_gridPos.x,
+                                 ( cX + cY ) / 2.f + m_gridPos.y };
+        }
+        
+        int TileRange::columnBegin( const int row ) const
+        {
+            return std::max( { 0, m_diffMin + row, m_sumMin - row } );
+        }
+        
+        int TileRange::columnEnd( const int row ) const
+        {
+            return std::min( { m_size, m_diffMax + row + 1, m_sumMax - row + 1 } );
+        }
+        
+        TileRange TileMap::tilesInRect( const sf::FloatRect& rect ) const
+        {
+            // Distance between two adjacent tiles along a map axis
+            const float step = TERRAIN_TILE_HEIGHT - 1.5f;
+            
+            // The top vertex of tile (x, y) is at
+            //   { gridPos.x + step * (x - y), gridPos.y + step * (x + y) / 2 }
+            // and its quad spans one tile height on either side of it in x, and
+            // one tile height below it in y. The quad overlaps the rectangle iff
+            //   left < top.x + TILE_HEIGHT, top.x - TILE_HEIGHT < right,
+            //   top < top.y + TILE_HEIGHT and top.y < bottom
+            // which bound x - y and x + y from either side.
+            float left   = ( rect.left - TERRAIN_TILE_HEIGHT - m_gridPos.x ) / step;
+            float right  = ( rect.left + rect.width + TERRAIN_TILE_HEIGHT - m_gridPos.x ) / step;
+            float top    = ( rect.top - TERRAIN_TILE_HEIGHT - m_gridPos.y ) * 2.f / step;
+            float bottom = ( rect.top + rect.height - m_gridPos.y ) * 2.f / step;
+            
+            TileRange range;
+            range.m_size    = m_size;
+            range.m_diffMin = static_cast<int>( std::floor( left ) ) + 1;
+            range.m_diffMax = static_cast<int>( std::ceil( right ) ) - 1;
+            range.m_sumMin  = static_cast<int>( std::floor( top ) ) + 1;
+            range.m_sumMax  = static_cast<int>( std::ceil( bottom ) ) - 1;
+            
+            // A row has columns in the range only if both the bands
+            // & the map overlap on it
+            range.m_rowBegin = std::max( { 0,
+                                           -range.m_diffMax,
+                                           range.m_sumMin - m_size + 1,
+                                           static_cast<int>( std::ceil( ( range.m_sumMin - range.m_diffMax ) / 2.f ) ) } );
+            range.m_rowEnd   = std::min( { m_size,
+                                           m_size - range.m_diffMin,
+                                           range.m_sumMax + 1,
+                                           static_cast<int>( std::floor( ( range.m_sumMax - range.m_diffMin ) / 2.f ) ) + 1 } );
+            
+            // A rectangle thinner than a tile may leave one of the bands empty
+            if ( range.m_diffMin > range.m_diffMax || range.m_sumMin > range.m_sumMax )
+                range.m_rowEnd = range.m_rowBegin;
+            
+            return range;
+        }
+        
+        const sf::IntRect& TileMap::changedArea() const
+        {
+            return m_changedArea;
+        }
+        
+        // https://stackoverflow.com/questions/27100729/find-which-tile-was-clicked-in-a-isometric-staggered-column-system
+        bool TileMap::tileContains( const int x, const int y, const sf::Vector2f point ) const
+        {
+            auto top = tilePosition( x, y );
+            sf::Vector2f center{ top.x, top.y + TERRAIN_TILE_HEIGHT * 0.5f };
+            float dx = std::abs( point.x - center.x );
+            float dy = std::abs( point.y - center.y );
             
-            for ( int y = 0; y < m_size; ++y )
+            return dx / ( TERRAIN_TILE_WIDTH * 0.5f - 1.f) + dy / ( TERRAIN_TILE_HEIGHT * 0.5f - 1.f ) < 1;
+        }
+        
+        bool TileMap::tileAt( const sf::Vector2f point, sf::Vector2i& tilePos ) const
+        {
+            const float step = TERRAIN_TILE_HEIGHT - 1.5f;
+            
+            // The center of tile (x, y) is at
+            //   { gridPos.x + step * (x - y), gridPos.y + TILE_HEIGHT / 2 + step * (x + y) / 2 }
+            // so inverting the projection gives x - y and x + y of the point
+            float diff = ( point.x - m_gridPos.x ) / step;
+            float sum  = ( point.y - m_gridPos.y - TERRAIN_TILE_HEIGHT * 0.5f ) * 2.f / step;
+            
+            float fx = ( sum + diff ) * 0.5f;
+            float fy = ( sum - diff ) * 0.5f;
+            
+            int x = static_cast<int>( std::round( fx ) );
+            int y = static_cast<int>( std::round( fy ) );
+            
+            // Adjacent tiles overlap slightly, so if the nearest tile misses
+            // the point, try its neighbor on the axis the point is furthest along
+            sf::Vector2i candidates[2] = { { x, y }, { x, y } };
+            if ( std::abs( fx - x ) >= std::abs( fy - y ) )
+                candidates[1].x += fx > x ? 1 : -1;
+            else
+                candidates[1].y += fy > y ? 1 : -1;
+            
+            for ( auto&& candidate : candidates )
             {
-                for ( int x = 0; x < m_size; ++x )
+                if ( candidate.x < 0 || candidate.x >= m_size || candidate.y < 0 || candidate.y >= m_size )
+                    continue;
+                
+                if ( tileContains( candidate.x, candidate.y, point ) )
                 {
-                    float cX = (TERRAIN_TILE_HEIGHT - 1.5) * x;
-                    float cY = (TERRAIN_TILE_HEIGHT - 1.5) * y;
-                    
-                    sf::Vector2f iso{ cX - cY + gridPos.x,
-                                      ( cX + cY ) / 2.f + gridPos.y };
-                                      
-                    m_tiles[y][x]->setPosition( iso );
+                    tilePos = candidate;
+                    return true;
                 }
             }
             
-            m_mapView.setSize( sf::Vector2f{ WINDOW_WIDTH, WINDOW_HEIGHT } );
-            m_mapView.setCenter( sf::Vector2f{ WINDOW_WIDTH / 2.f, m_size * TERRAIN_TILE_HEIGHT * 0.5f } );
-            window.setView( m_mapView );
+            return false;
+        }
+        
+        void TileMap::buildQuad( const int x, const int y, sf::Vertex* quad ) const
+        {
+            auto position = tilePosition( x, y );
             
-            LOG(Logger::Level::INFO) << "TileMap successfully created" << std::endl;
+            quad[0].position = position;
+            quad[1].position = sf::Vector2f{ position.x + TERRAIN_TILE_HEIGHT, position.y + TERRAIN_TILE_HEIGHT * 0.5f };
+            quad[2].position = sf::Vector2f{ position.x, position.y + TERRAIN_TILE_HEIGHT };
+            quad[3].position = sf::Vector2f{ position.x - TERRAIN_TILE_HEIGHT, position.y + TERRAIN_TILE_HEIGHT * 0.5f };
+            
+            quad[0].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, 0.f };
+            quad[1].texCoords = sf::Vector2f{ TERRAIN_TILE_WIDTH, TERRAIN_TILE_HEIGHT * 0.5f };
+            quad[2].texCoords = sf::Vector2f{ TERRAIN_TILE_HEIGHT, TERRAIN_TILE_HEIGHT };
+            quad[3].texCoords = sf::Vector2f{ 0.f, TERRAIN_TILE_HEIGHT * 0.5f };
+            
+            for ( int v = 0; v < 4; ++v )
+                quad[v].color = sf::Color::White;
         }
         
-        TileMap::~TileMap()
+        TileChunk& TileMap::chunk( const int cx, const int cy )
         {
-            for ( int y = 0; y < m_size; ++y )
+            return m_chunks[cy * m_chunkCount + cx];
+        }
+        
+        void TileMap::markDirty( const int x, const int y )
+        {
+            if ( x < 0 || x >= m_size || y < 0 || y >= m_size )
+                return;
+            
+            // Grow the dirty area to hold the tile
+            if ( m_dirtyArea.width == 0 )
+            {
+                m_dirtyArea = sf::IntRect{ x, y, 1, 1 };
+            }
+            else
             {
-                for ( int x = 0; x < m_size; ++x )
+                int x0 = std::min( m_dirtyArea.left, x );
+                int y0 = std::min( m_dirtyArea.top, y );
+                int x1 = std::max( m_dirtyArea.left + m_dirtyArea.width, x + 1 );
+                int y1 = std::max( m_dirtyArea.top + m_dirtyArea.height, y + 1 );
+                
+                m_dirtyArea = sf::IntRect{ x0, y0, x1 - x0, y1 - y0 };
+            }
+        }
+        
+        void TileMap::appendQuad( TileChunk::Layer& layer, const TextureID texID, const sf::Vertex* quad ) const
+        {
+            const auto& region = m_regions[static_cast<int>( texID )];
+            if ( !region.m_texture )
+                return;
+            
+            sf::VertexArray& batch = layer[region.m_texture];
+            batch.setPrimitiveType( sf::Quads );
+            
+            for ( int v = 0; v < 4; ++v )
+            {
+                sf::Vertex vertex = quad[v];
+                vertex.texCoords.x += region.m_rect.left;
+                vertex.texCoords.y += region.m_rect.top;
+                batch.append( vertex );
+            }
+        }
+        
+        void TileMap::rebuildChunk( const int cx, const int cy )
+        {
+            TileChunk& tileChunk = chunk( cx, cy );
+            
+            // Keep the arrays (and their storage) around, only drop their vertices
+            for ( auto&& layer : tileChunk.m_layers )
+                for ( auto&& batch : layer )
+                    batch.second.clear();
+            
+            for ( auto&& batch : tileChunk.m_animated )
+                batch.second.clear();
+            
+            int x0 = cx * TILE_CHUNK_SIZE;
+            int y0 = cy * TILE_CHUNK_SIZE;
+            int x1 = std::min( x0 + TILE_CHUNK_SIZE, m_size );
+            int y1 = std::min( y0 + TILE_CHUNK_SIZE, m_size );
+            
+            sf::Vertex quad[4];
+            
+            for ( int y = y0; y < y1; ++y )
+            {
+                for ( int x = x0; x < x1; ++x )
                 {
-                    m_tiles[y][x].reset();
+                    const Tile& current = renderTile( x, y );
+                    buildQuad( x, y, quad );
+                    
+                    // Base texture, animated quads start at the first frame
+                    appendQuad( current.tileAnimated() ? tileChunk.m_animated : tileChunk.m_layers[0], current.getTexture(), quad );
+                    
+                    // Overlays
+                    for ( int i = 0; i < TERRAIN_COUNT - 1; ++i )
+                        for ( int j = 0; j < 2; ++j )
+                        {
+                            if ( current.m_overlays[i][j] != TextureID::INVALID )
+                            {
+                                if ( Tile::precedence( current.getType() ) - 1 < i )
+                                    appendQuad( tileChunk.m_layers[i + 1], current.m_overlays[i][j], quad );
+                            }
+                        }
                 }
             }
-            LOG(Logger::Level::INFO) << "TileMap destroyed." << std::endl;
+            
+            tileChunk.m_dirty = false;
+            
+            // Bring the animated quads to the current frame
+            tileChunk.m_animationOffset = 0.f;
+            syncAnimatedQuads( tileChunk );
         }
         
-//         bool TileMap::generate( const int size, sf::RenderWindow& window )
-//         {
-//             m_size = size;
-//             m_selectedTile = TextureID::TERRAIN_TILE_LAND_DEFAULT;
-//             m_window = &window;
-//          
-//             LOG(Logger::Level::INFO) << "Creating TileMap..." << std::endl;
-//             
-//             // Create a sizexsize 2D grid of tiles
-//             m_tiles.resize( m_size, std::vector<Tile>( m_size, Tile() ) );
-//             
-//             // Position of tile (0,0)
-//             const sf::Vector2f gridPos{ window.getSize().x / 2.f, 0.f };
-//             
-//             for ( int y = 0; y < m_size; ++y )
-//             {
-//                 for ( int x = 0; x < m_size; ++x )
-//                 {
-//                     float cX = 63.f * x;
-//                     float cY = 63.f * y;
-//                     
-//                     sf::Vector2f iso{ cX - cY + gridPos.x,
-//                                       ( cX + cY ) / 2.f + gridPos.y };
-//                     
-//                     m_tiles[y][x].setPosition( iso );
-//                 }
-//             }
-//             
-//             m_mapView.setSize( sf::Vector2f{ WINDOW_WIDTH, WINDOW_HEIGHT } );
-//             m_mapView.setCenter( sf::Vector2f{ WINDOW_WIDTH / 2.f, m_size * TERRAIN_TILE_HEIGHT * 0.5f } );
-//             window.setView( m_mapView );
-//             
-//             LOG(Logger::Level::INFO) << "TileMap successfully created" << std::endl;
-//             
-//             return true;
-//         }
-                
-        void TileMap::handleInput()
+        void TileMap::syncAnimatedQuads( TileChunk& tileChunk )
+        {
+            float offset = m_animationOffset;
+            
+            if ( tileChunk.m_animationOffset == offset )
+                return;
+            
+            for ( auto&& batch : tileChunk.m_animated )
+                for ( std::size_t v = 0; v < batch.second.getVertexCount(); ++v )
+                    batch.second[v].texCoords.x += offset - tileChunk.m_animationOffset;
+            
+            tileChunk.m_animationOffset = offset;
+        }
+        
+        void TileMap::paintTile( const int x, const int y, const TextureID texID )
         {
+            Tile& current = tile( x, y );
+            
+            // The overlays around the tile are already resolved for its texture
+            if ( current.getTexture() == texID )
+                return;
             
+            current.setTexture( texID );
+            current.setType( getTerrainType( texID ) );
+            current.setAnimated( isAnimatedTexture( texID ) );
+            
+            markDirty( x, y );
+            
+            // The overlays of the neighbors change as well
+            autotile( sf::IntRect{ x - 1, y - 1, 3, 3 } );
         }
         
-        void TileMap::update( const sf::Time dt )
+        void TileMap::autotile( const sf::IntRect& area )
         {
-            if ( m_window->isOpen() && !CManager::UIComponent::m_mouseOverUIWidget )
+            int x0 = std::max( area.left, 0 );
+            int y0 = std::max( area.top, 0 );
+            int x1 = std::min( area.left + area.width, m_size );
+            int y1 = std::min( area.top + area.height, m_size );
+            
+            for ( int y = y0; y < y1; ++y )
             {
-                auto screenMousePos = sf::Mouse::getPosition(*m_window);
-                auto mousePos = static_cast<sf::Vector2f>( m_window->mapPixelToCoords( sf::Mouse::getPosition(*m_window) ) );
-
-                float scroll = 350.f;
-                bool mouseDown = sf::Mouse::isButtonPressed(sf::Mouse::Left);
-                
-                bool static once = true;                    
-                
-//                 for ( auto&& tileRow : m_tiles )
-//                 {
-//                     for ( auto&& tile : tileRow )
-                for ( int y = 0; y < m_size; ++y )
+                for ( int x = x0; x < x1; ++x )
                 {
-                    for ( int x = 0; x < m_size; ++x )
+                    // A tile is overlaid with the transitions of the terrains
+                    // of its neighbors, one mask for each terrain
+                    Tile::NeighborMask straight[TERRAIN_COUNT] = {};
+                    Tile::NeighborMask diagonal[TERRAIN_COUNT] = {};
+                    
+                    for ( int i = 0; i < 4; ++i )
                     {
-                        if ( m_tiles[y][x]->inWorldView( m_mapView ) )
-                        {
-                            if ( AnimationManager::AnimationManager::exists( "tile-anim-" + std::to_string( long( m_tiles[y][x]->getQuad() ) ) ) )
-                                AnimationManager::AnimationManager::setVisibility( "tile-anim-" + std::to_string( long( m_tiles[y][x]->getQuad() ) ), true );
-                            
-                        auto tile = m_tiles[y][x];
+                        int nx = x + stNeighbors[i][0];
+                        int ny = y + stNeighbors[i][1];
                         
-                        // Highlight mouseover tile
-                        if ( tile->contains( mousePos ) )
-                                tile->setFillColor( sf::Color( 200, 200, 200, 200 ) );
-                            else
-                                tile->setFillColor( sf::Color( 255, 255, 255, 255 ) );
+                        if ( nx >= 0 && nx < m_size && ny >= 0 && ny < m_size )
+                            straight[Tile::precedence( tile( nx, ny ).getType() )] |= Tile::NeighborMask( 1 << i );
                         
-                        // Update tile texture
-                        if ( mouseDown && tile->contains( mousePos ) )// && once )
+                        nx = x + diaNeighbors[i][0];
+                        ny = y + diaNeighbors[i][1];
+                        
+                        if ( nx >= 0 && nx < m_size && ny >= 0 && ny < m_size )
+                            diagonal[Tile::precedence( tile( nx, ny ).getType() )] |= Tile::NeighborMask( 1 << i );
+                    }
+                    
+                    Tile& current = tile( x, y );
+                    bool changed = false;
+                    
+                    for ( int prec = 1; prec < TERRAIN_COUNT; ++prec )
+                    {
+                        TextureID overlays[2] = { Tile::getOverlayTexture( prec, 0, straight[prec] ),
+                                                  Tile::getOverlayTexture( prec, 1, diagonal[prec] ) };
+                        
+                        for ( int j = 0; j < 2; ++j )
                         {
-                            once = false;
-//                             if ( tile->tileAnimated() )
-//                             {
-//                                 AnimationManager::AnimationManager::destroyAnimation( "tile-anim-" + std::to_string( long(tile->getQuad()) ) );
-//                                 tile->setAnimated(false);
-//                             }
-                            
-                            // Change tile to the current selected tile
-                            if ( isAnimatedTexture( m_selectedTile ) )
+                            if ( current.m_overlays[prec - 1][j] != overlays[j] )
                             {
-                                AnimationManager::AnimationManager::createAnimation( "tile-anim-" + std::to_string( long(tile->getQuad()) ), tile->getQuad(), sf::Vector2i{ 128, 64 }, 2, sf::seconds(1.f) );
-                                tile->setAnimated(true);
+                                current.setOverlayTexture( prec - 1, j, overlays[j] );
+                                changed = true;
                             }
-                            
-                            // Update the texture and type of the current, selected tile
-                            
-                            // 1. First update the base texture for the selected tile
-                            tile->setTexture( m_selectedTile );
-                            tile->setType( getTerrainType( m_selectedTile ) );
-                            
-                            // Reset overlay info for the selected tile
-                            
-                            // Precedence of the current tile
-                            auto currentPrec = Tile::m_precedences[getTerrainType(m_selectedTile)];
-                                                        
-                            // The elemens represent the following:
-                            // { x-offset, y-offset, adjacent side of neighbor, adjacent side of current }
-                            static const int stNeighbors[4][4] =
-                            {
-                                {  0, -1,  3,  1 }, // N
-                                {  1,  0,  4,  2 }, // E
-                                {  0,  1,  1,  3 }, // S
-                                { -1,  0,  2,  4 }  // W
-                            };
-                            
-                            // The elemens represent the following:
-                            // { x-offset, y-offset, adjacent side of neighbor, adjacent side of current }
-                            static const int diaNeighbors[4][4] =
-                            {
-                                {  1, -1, 3, 1 }, // NE
-                                {  1,  1, 4, 2 }, // SE
-                                { -1,  1, 1, 3 }, // SW
-                                { -1, -1, 2, 4 }  // NW
-                            };
-                            
-                            for ( int prec = 0; prec < TERRAIN_COUNT; ++prec )
-                            {
-                                for ( int i = 0; i < 4; ++i )
-                                {
-                                    int nx = x + stNeighbors[i][0];
-                                    int ny = y + stNeighbors[i][1];
-                                    
-                                    // If neighbor is within bounds, check and set overlay
-                                    if ( nx >= 0 && nx < m_size &&
-                                        ny >= 0 && ny < m_size )
-                                    {
-                                        int neighborPrec = Tile::m_precedences[ m_tiles[ny][nx]->getType() ];
-                                        
-                                        if ( prec == neighborPrec )
-                                        {
-                                            // If the precedence of the current tile is lesser than the neighbor,
-                                            // it is overlaid with the transition for the neighbor.
-                                            if ( currentPrec < neighborPrec )
-                                            {
-                                                m_tiles[ny][nx]->m_neighborsStraight[neighborPrec].set( stNeighbors[i][2] - 1, true );
-                                                m_tiles[ny][nx]->setOverlayTexture( neighborPrec - 1, 0, Tile::getOverlayTexture( std::to_string( neighborPrec ) + "-0-" + m_tiles[ny][nx]->m_neighborsStraight[neighborPrec].to_string() ) );
-                                                
-                                                tile->m_neighborsStraight[neighborPrec - 0].set( stNeighbors[i][3] - 1, true );
-                                                tile->setOverlayTexture( neighborPrec - 1, 0, Tile::getOverlayTexture( std::to_string( neighborPrec ) + "-0-" + tile->m_neighborsStraight[neighborPrec].to_string() ) );
-                                            }
-                                            
-                                            // If the precedence of the current tile is equal to the neighbor,
-                                            // then remove the overlay for that side from the neighbor and also
-                                            // remove any overlay of the current tile from that side. 
-                                            if ( currentPrec == neighborPrec )
-                                            {
-                                                tile->m_neighborsStraight[currentPrec - 0].set( stNeighbors[i][3] - 1, true );
-                                                tile->setOverlayTexture( currentPrec - 1, 0, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-0-" + tile->m_neighborsStraight[currentPrec].to_string() ) );
-                                                
-                                                m_tiles[ny][nx]->m_neighborsStraight[currentPrec - 0].set( stNeighbors[i][2] - 1, true );
-                                                m_tiles[ny][nx]->setOverlayTexture( currentPrec - 1, 0, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-0-" + m_tiles[ny][nx]->m_neighborsStraight[currentPrec].to_string() ) );
-                                            }
-                                            
-                                            // If the precedence of the current tile is higher than the neighbor,
-                                            // then overlay the neighbor with the transition for the current tile
-                                            // along with any other previous transitions.
-                                            if ( currentPrec > neighborPrec )
-                                            {
-                                                m_tiles[ny][nx]->m_neighborsStraight[currentPrec - 0].set( stNeighbors[i][2] - 1, true );
-                                                m_tiles[ny][nx]->setOverlayTexture( currentPrec - 1, 0, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-0-" + m_tiles[ny][nx]->m_neighborsStraight[currentPrec].to_string() ) );
-                                            }
-                                            
-                                            for ( auto p1 = 1; p1 < currentPrec; ++p1 )
-                                            {
-                                                m_tiles[ny][nx]->m_neighborsStraight[p1 - 0].set( stNeighbors[i][2] - 1, false );
-                                                m_tiles[ny][nx]->setOverlayTexture( p1 - 1, 0, Tile::getOverlayTexture( std::to_string( p1 ) + "-0-" + m_tiles[ny][nx]->m_neighborsStraight[p1].to_string() ) );
-                                            }
-                                            
-                                            for ( auto p1 = currentPrec + 1; p1 < Tile::m_precedences.size(); ++p1 )
-                                            {
-                                                m_tiles[ny][nx]->m_neighborsStraight[p1 - 0].set( stNeighbors[i][2] - 1, false );
-                                                m_tiles[ny][nx]->setOverlayTexture( p1 - 1, 0, Tile::getOverlayTexture( std::to_string( p1 ) + "-0-" + m_tiles[ny][nx]->m_neighborsStraight[p1].to_string() ) );
-                                            }
-                                        }
-                                    }
-                                    
-                                    nx = x + diaNeighbors[i][0];
-                                    ny = y + diaNeighbors[i][1];
-                                    
-                                    // If neighbor is within bounds, check and set overlay
-                                    if ( nx >= 0 && nx < m_size &&
-                                        ny >= 0 && ny < m_size )
-                                    {
-                                        int neighborPrec = Tile::m_precedences[ m_tiles[ny][nx]->getType() ];
-                                        
-                                        if ( prec == neighborPrec )
-                                        {
-                                            if ( currentPrec < neighborPrec )
-                                            {
-                                                m_tiles[ny][nx]->m_neighborsDiagonal[neighborPrec].set( diaNeighbors[i][2] - 1, true );
-                                                m_tiles[ny][nx]->setOverlayTexture( neighborPrec - 1, 1, Tile::getOverlayTexture( std::to_string( neighborPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[neighborPrec].to_string() ) );
-                                                
-                                                tile->m_neighborsDiagonal[neighborPrec - 0].set( diaNeighbors[i][3] - 1, true );
-                                                tile->setOverlayTexture( neighborPrec - 1, 1, Tile::getOverlayTexture( std::to_string( neighborPrec ) + "-1-" + tile->m_neighborsDiagonal[neighborPrec].to_string() ) );
-                                            }
-                                            
-                                            if ( currentPrec == neighborPrec && currentPrec > 0)
-                                            {
-                                                tile->m_neighborsDiagonal[currentPrec - 0].set( diaNeighbors[i][3] - 1, true );
-                                                tile->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + tile->m_neighborsDiagonal[currentPrec].to_string() ) );
-                                                
-                                                m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec - 0].set( diaNeighbors[i][2] - 1, true );
-                                                m_tiles[ny][nx]->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec].to_string() ) );
-                                            }
-                                            
-                                            if ( currentPrec > neighborPrec )
-                                            {
-                                                m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec].set( diaNeighbors[i][2] - 1, true );
-                                                m_tiles[ny][nx]->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[ currentPrec ].to_string() ) );
-                                            }
-                                            
-                                            for ( auto p1 = 1; p1 < currentPrec; ++p1 )
-                                            {
-                                                m_tiles[ny][nx]->m_neighborsDiagonal[p1 - 0].set( diaNeighbors[i][2] - 1, false );
-                                                m_tiles[ny][nx]->setOverlayTexture( p1 - 1, 1, Tile::getOverlayTexture( std::to_string( p1 ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[p1].to_string() ) );
-                                            }
-                                            
-                                            for ( auto p1 = currentPrec + 1; p1 < Tile::m_precedences.size(); ++p1 )
-                                            {
-                                                m_tiles[ny][nx]->m_neighborsDiagonal[p1 - 0].set( diaNeighbors[i][2] - 1, false );
-                                                m_tiles[ny][nx]->setOverlayTexture( p1 - 1, 1, Tile::getOverlayTexture( std::to_string( p1 ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[p1].to_string() ) );
-                                            }
-                                        }
-                                    }
-                                }
-                                
-//                                 for ( int i = 0; i < 4; ++i )
-//                                 {
-//                                     int nx = x + diaNeighbors[i][0];
-//                                     int ny = y + diaNeighbors[i][1];
-//                                     
-//                                     // If neighbor is within bounds, check and set overlay
-//                                     if ( nx >= 0 && nx < m_size &&
-//                                         ny >= 0 && ny < m_size )
-//                                     {
-//                                         int neighborPrec = Tile::m_precedences[ m_tiles[ny][nx]->getType() ];
-//                                         
-//                                         if ( prec == neighborPrec )
-//                                         {
-//                                             if ( currentPrec < neighborPrec )
-//                                             {
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[neighborPrec].set( diaNeighbors[i][2] - 1, true );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( neighborPrec - 1, 1, Tile::getOverlayTexture( std::to_string( neighborPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[neighborPrec].to_string() ) );
-//                                                 
-//                                                 tile->m_neighborsDiagonal[neighborPrec - 0].set( diaNeighbors[i][3] - 1, true );
-//                                                 tile->setOverlayTexture( neighborPrec - 1, 1, Tile::getOverlayTexture( std::to_string( neighborPrec ) + "-1-" + tile->m_neighborsDiagonal[neighborPrec].to_string() ) );
-//                                             }
-//                                             
-//                                             if ( currentPrec == neighborPrec && currentPrec > 0)
-//                                             {
-//                                                 tile->m_neighborsDiagonal[currentPrec - 0].set( diaNeighbors[i][3] - 1, true );
-//                                                 tile->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + tile->m_neighborsDiagonal[currentPrec].to_string() ) );
-//                                                 
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec - 0].set( diaNeighbors[i][2] - 1, true );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec].to_string() ) );
-//                                             }
-//                                             
-//                                             if ( currentPrec > neighborPrec )
-//                                             {
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec].set( diaNeighbors[i][2] - 1, true );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[ currentPrec ].to_string() ) );
-//                                             }
-//                                             
-//                                             for ( auto p1 = 1; p1 < currentPrec; ++p1 )
-//                                             {
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[p1 - 0].set( diaNeighbors[i][2] - 1, false );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( p1 - 1, 1, Tile::getOverlayTexture( std::to_string( p1 ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[p1].to_string() ) );
-//                                             }
-//                                             
-//                                             for ( auto p1 = currentPrec + 1; p1 < Tile::m_precedences.size(); ++p1 )
-//                                             {
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[p1 - 0].set( diaNeighbors[i][2] - 1, false );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( p1 - 1, 1, Tile::getOverlayTexture( std::to_string( p1 ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[p1].to_string() ) );
-//                                             }
-//                                         }
-//                                     }
-//                                 }
-                            }
-                            
-//                             for ( int prec = 0; prec < TERRAIN_COUNT; ++prec )
-//                             {
-//                                 for ( int i = 0; i < 4; ++i )
-//                                 {
-//                                     int nx = x + diaNeighbors[i][0];
-//                                     int ny = y + diaNeighbors[i][1];
-//                                     
-//                                     // If neighbor is within bounds, check and set overlay
-//                                     if ( nx >= 0 && nx < m_size &&
-//                                         ny >= 0 && ny < m_size )
-//                                     {
-//                                         int neighborPrec = Tile::m_precedences[ m_tiles[ny][nx]->getType() ];
-//                                         
-//                                         if ( prec == neighborPrec )
-//                                         {
-//                                             if ( currentPrec < neighborPrec )
-//                                             {
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[neighborPrec].set( diaNeighbors[i][2] - 1, true );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( neighborPrec - 1, 1, Tile::getOverlayTexture( std::to_string( neighborPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[neighborPrec].to_string() ) );
-//                                                 
-//                                                 tile->m_neighborsDiagonal[neighborPrec - 0].set( diaNeighbors[i][3] - 1, true );
-//                                                 tile->setOverlayTexture( neighborPrec - 1, 1, Tile::getOverlayTexture( std::to_string( neighborPrec ) + "-1-" + tile->m_neighborsDiagonal[neighborPrec].to_string() ) );
-//                                             }
-//                                             
-//                                             if ( currentPrec == neighborPrec && currentPrec > 0)
-//                                             {
-//                                                 tile->m_neighborsDiagonal[currentPrec - 0].set( diaNeighbors[i][3] - 1, true );
-//                                                 tile->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + tile->m_neighborsDiagonal[currentPrec].to_string() ) );
-//                                                 
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec - 0].set( diaNeighbors[i][2] - 1, true );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec].to_string() ) );
-//                                             }
-//                                             
-//                                             if ( currentPrec > neighborPrec )
-//                                             {
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[currentPrec].set( diaNeighbors[i][2] - 1, true );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( currentPrec - 1, 1, Tile::getOverlayTexture( std::to_string( currentPrec ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[ currentPrec ].to_string() ) );
-//                                             }
-//                                             
-//                                             for ( auto p1 = 1; p1 < currentPrec; ++p1 )
-//                                             {
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[p1 - 0].set( diaNeighbors[i][2] - 1, false );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( p1 - 1, 1, Tile::getOverlayTexture( std::to_string( p1 ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[p1].to_string() ) );
-//                                             }
-//                                             
-//                                             for ( auto p1 = currentPrec + 1; p1 < Tile::m_precedences.size(); ++p1 )
-//                                             {
-//                                                 m_tiles[ny][nx]->m_neighborsDiagonal[p1 - 0].set( diaNeighbors[i][2] - 1, false );
-//                                                 m_tiles[ny][nx]->setOverlayTexture( p1 - 1, 1, Tile::getOverlayTexture( std::to_string( p1 ) + "-1-" + m_tiles[ny][nx]->m_neighborsDiagonal[p1].to_string() ) );
-//                                             }
-//                                         }
-//                                     }
-//                                 }
-//                             }
                         }
-                        
-                        if ( !mouseDown )
-                            once = true;
-                    }
                     }
+                    
+                    // Only the tiles whose overlays differ count as changed
+                    if ( changed )
+                        markDirty( x, y );
                 }
+            }
+        }
+        
+        void TileMap::evictChunks()
+        {
+            // Most recently seen first, so the chunks in view are always kept
+            std::sort( m_residentChunks.begin(), m_residentChunks.end(),
+                       [this]( const int a, const int b )
+                       {
+                           return m_chunks[a].m_lastVisible > m_chunks[b].m_lastVisible;
+                       } );
+            
+            std::size_t keep = std::max( static_cast<std::size_t>( TILE_CHUNK_BUDGET ), m_visibleChunks.size() );
+            
+            for ( std::size_t i = keep; i < m_residentChunks.size(); ++i )
+            {
+                TileChunk& tileChunk = m_chunks[m_residentChunks[i]];
                 
-                // View scrolling
+                for ( auto&& layer : tileChunk.m_layers )
+                    layer.clear();
                 
-                if ( screenMousePos.x <= 0 )
-                {
-                    if ( m_mapView.getCenter().x - m_mapView.getSize().x * 0.5f > m_tiles[m_size - 1][0]->getPosition(3).x )
-                    {
-                        m_mapView.move( sf::Vector2f{ -scroll * dt.asSeconds(), 0 } );
-                        m_window->setView( m_mapView );
-                    }
-                }
-                else if ( screenMousePos.x >= WINDOW_WIDTH - 1 )
+                tileChunk.m_animated.clear();
+                tileChunk.m_resident = false;
+            }
+            
+            m_residentChunks.resize( keep );
+        }
+        
+        void TileMap::publishChanges()
+        {
+            // Publish the tiles changed during this update
+            m_changedArea = m_dirtyArea;
+            m_dirtyArea = sf::IntRect{};
+            
+            if ( m_changedArea.width == 0 )
+                return;
+            
+            std::lock_guard<std::mutex> lock( m_changesMutex );
+            
+            for ( int y = m_changedArea.top; y < m_changedArea.top + m_changedArea.height; ++y )
+                for ( int x = m_changedArea.left; x < m_changedArea.left + m_changedArea.width; ++x )
+                    m_changes.push_back( TileChange{ y * m_size + x, tile( x, y ) } );
+        }
+        
+        void TileMap::handleInput()
+        {
+            m_input.m_overMap = m_window->isOpen() && !CManager::UIComponent::m_mouseOverUIWidget;
+            
+            if ( !m_input.m_overMap )
+                return;
+            
+            // Pick against the view drawn last, the one the mouse was seen over
+            m_input.m_screenPos = sf::Mouse::getPosition( *m_window );
+            m_input.m_worldPos = m_window->mapPixelToCoords( m_input.m_screenPos );
+            m_input.m_down = sf::Mouse::isButtonPressed( sf::Mouse::Left );
+        }
+        
+        void TileMap::update( const sf::Time dt )
+        {
+            sf::Vector2f scrollDirection;
+            sf::Vector2i hovered{ -1, -1 };
+            
+            if ( m_input.m_overMap )
+            {
+                // Paint the tile under the mouse
+                if ( !tileAt( m_input.m_worldPos, hovered ) )
+                    hovered = sf::Vector2i{ -1, -1 };
+                
+                if ( m_input.m_down && hovered.x >= 0 )
+                    paintTile( hovered.x, hovered.y, m_selectedTile );
+                
+                // Scroll the map while the mouse is at an edge of the window
+                if ( m_input.m_screenPos.x <= 0 )
+                    scrollDirection.x = -1.f;
+                else if ( m_input.m_screenPos.x >= WINDOW_WIDTH - 1 )
+                    scrollDirection.x = 1.f;
+                
+                if ( m_input.m_screenPos.y <= 0 )
+                    scrollDirection.y = -1.f;
+                else if ( m_input.m_screenPos.y >= WINDOW_HEIGHT - 1 )
+                    scrollDirection.y = 1.f;
+            }
+            
+            m_camera.setScrollDirection( scrollDirection );
+            m_camera.update( dt );
+            
+            publishChanges();
+            
+            TileMapSnapshot& snapshot = m_snapshots.back();
+            snapshot.m_view = m_camera.getView();
+            snapshot.m_previousCenter = m_camera.getPreviousCenter();
+            snapshot.m_hoveredTile = hovered;
+            m_snapshots.publish();
+        }
+        
+        void TileMap::prepareFrame( const float alpha )
+        {
+            // Take in the tiles changed by the updates since the last frame
+            {
+                std::lock_guard<std::mutex> lock( m_changesMutex );
+                m_renderChanges.swap( m_changes );
+            }
+            
+            for ( auto&& change : m_renderChanges )
+            {
+                m_renderTiles[change.m_index] = change.m_tile;
+                chunk( ( change.m_index % m_size ) / TILE_CHUNK_SIZE, ( change.m_index / m_size ) / TILE_CHUNK_SIZE ).m_dirty = true;
+            }
+            
+            m_renderChanges.clear();
+            
+            m_snapshots.fetch();
+            const TileMapSnapshot& snapshot = m_snapshots.front();
+            
+            // Show the camera between where it was before & after the update
+            sf::View view = snapshot.m_view;
+            view.setCenter( snapshot.m_previousCenter + ( snapshot.m_view.getCenter() - snapshot.m_previousCenter ) * alpha );
+            
+            // Set the view on the window only when it has moved
+            const sf::View& applied = m_window->getView();
+            if ( applied.getCenter() != view.getCenter() || applied.getSize() != view.getSize() )
+                m_window->setView( view );
+            
+            sf::FloatRect viewRect{ view.getCenter() - view.getSize() * 0.5f, view.getSize() };
+            
+            // Animations outside of the view are not updated
+            AnimationManager::AnimationManager::setViewRect( viewRect );
+            
+            // Only move the shade when the mouse enters another tile
+            if ( snapshot.m_hoveredTile != m_hoveredTile )
+            {
+                if ( snapshot.m_hoveredTile.x >= 0 )
                 {
-                    if ( m_mapView.getCenter().x + m_mapView.getSize().x * 0.5f < m_tiles[0][m_size - 1]->getPosition(1).x )
+                    sf::Vertex quad[4];
+                    buildQuad( snapshot.m_hoveredTile.x, snapshot.m_hoveredTile.y, quad );
+                    
+                    for ( int v = 0; v < 4; ++v )
                     {
-                        m_mapView.move( sf::Vector2f{ scroll * dt.asSeconds(), 0 } );
-                        m_window->setView( m_mapView );
+                        m_hoverQuad[v].position = quad[v].position;
+                        m_hoverQuad[v].color = sf::Color( 0, 0, 0, 55 );
                     }
                 }
-                if ( screenMousePos.y <= 0 )
+                
+                m_hoveredTile = snapshot.m_hoveredTile;
+            }
+            
+            // Find the chunks in view and bring them up to date. The columns
+            // of a chunk row in view are the union of the columns of its rows.
+            
+            auto range = tilesInRect( viewRect );
+            m_visibleChunks.clear();
+            
+            // The frames of the animated tiles lie side by side in their textures
+            if ( AnimationManager::AnimationManager::exists( m_animation ) )
+                m_animationOffset = static_cast<float>( AnimationManager::AnimationManager::getFrameRect( m_animation ).left );
+            
+            for ( int y0 = range.m_rowBegin; y0 < range.m_rowEnd; y0 = ( y0 / TILE_CHUNK_SIZE + 1 ) * TILE_CHUNK_SIZE )
+            {
+                int cy = y0 / TILE_CHUNK_SIZE;
+                int y1 = std::min( ( cy + 1 ) * TILE_CHUNK_SIZE, range.m_rowEnd );
+                int x0 = m_size, x1 = 0;
+                
+                for ( int y = y0; y < y1; ++y )
                 {
-                    if ( m_mapView.getCenter().y - m_mapView.getSize().y * 0.5f > m_tiles[0][0]->getPosition(0).y )
-                    {
-                        m_mapView.move( sf::Vector2f{ 0, -scroll * dt.asSeconds() } );
-                        m_window->setView( m_mapView );
-                    }
+                    x0 = std::min( x0, range.columnBegin( y ) );
+                    x1 = std::max( x1, range.columnEnd( y ) );
                 }
-                else if ( screenMousePos.y >= WINDOW_HEIGHT - 1 )
+                
+                for ( int cx = x0 / TILE_CHUNK_SIZE; cx * TILE_CHUNK_SIZE < x1; ++cx )
                 {
-                    if ( m_mapView.getCenter().y + m_mapView.getSize().y * 0.5f < m_tiles[m_size - 1][m_size - 1]->getPosition(2).y )
+                    TileChunk& tileChunk = chunk( cx, cy );
+                    
+                    if ( !tileChunk.m_resident )
                     {
-                        m_mapView.move( sf::Vector2f{ 0, scroll * dt.asSeconds() } );
-                        m_window->setView( m_mapView );
+                        rebuildChunk( cx, cy );
+                        tileChunk.m_resident = true;
+                        m_residentChunks.push_back( cy * m_chunkCount + cx );
                     }
+                    else if ( tileChunk.m_dirty )
+                        rebuildChunk( cx, cy );
+                    else
+                        syncAnimatedQuads( tileChunk );
+                    
+                    tileChunk.m_lastVisible = m_frame;
+                    m_visibleChunks.push_back( cy * m_chunkCount + cx );
                 }
-                
-//                 
-//                 // Panning
-//                 if ( sf::Mouse::isButtonPressed( sf::Mouse::Left ) && event.type == sf::Event::MouseMoved )
-//                 {
-//                     /*auto mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
-//                     m_mapView.setCenter( { std::abs( mousePos.x + 0 ), std::abs( mousePos.y + 0 ) } );
-//                     window.setView(m_mapView);*/
-//                 }
-            }            
+            }
+            
+            if ( m_residentChunks.size() > static_cast<std::size_t>( TILE_CHUNK_BUDGET ) )
+                evictChunks();
             
+            ++m_frame;
         }
         
         void TileMap::setSelectedTile( const TextureID texID )
@@ -983,21 +759,43 @@ namespace rts
         
         void TileMap::draw(sf::RenderTarget& target, sf::RenderStates states) const
         {
-            // TODO: After testing, make the rendering follow depth order
-//             for ( auto&& tileRow : m_tiles )
-//                 for ( auto&& tile : tileRow )
-//                     target.draw( tile, states);
-            for ( int y = 0; y < m_size ; ++y )
+            states.transform *= getTransform();
+            
+            // One draw call per layer, atlas texture & visible chunk. All the base
+            // terrain goes first so that overlays are never covered by the
+            // base of a neighboring chunk.
+            for ( int layer = 0; layer < TILE_CHUNK_LAYERS; ++layer )
             {
-                for ( int x = 0; x < m_size ; ++x )
+                for ( auto&& c : m_visibleChunks )
                 {
-                    if ( m_tiles[y][x]->inWorldView( m_mapView ) )
+                    for ( auto&& batch : m_chunks[c].m_layers[layer] )
                     {
-                        states.transform *= getTransform();
-                        target.draw( *m_tiles[y][x], states);
+                        if ( batch.second.getVertexCount() == 0 )
+                            continue;
+                        
+                        states.texture = batch.first;
+                        target.draw( batch.second, states );
+                    }
+                    
+                    if ( layer != 0 )
+                        continue;
+                    
+                    for ( auto&& batch : m_chunks[c].m_animated )
+                    {
+                        if ( batch.second.getVertexCount() == 0 )
+                            continue;
+                        
+                        states.texture = batch.first;
+                        target.draw( batch.second, states );
                     }
                 }
             }
+            
+            if ( m_hoveredTile.x >= 0 )
+            {
+                states.texture = nullptr;
+                target.draw( m_hoverQuad, states );
+            }
         }
     }
 }
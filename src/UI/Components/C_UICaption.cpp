@@ -15,6 +15,11 @@
  * 
  */
 
+#include <algorithm>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
 #include "Utility/Log.hpp"
 #include "Utility/Constants.hpp"
 #include "ResourceManager/ResourceManager.hpp"
@@ -26,6 +31,270 @@ namespace rts
     {
         namespace UIComponent
         {
+            constexpr std::size_t CaptionText::CLEAN;
+            
+            std::map<CaptionText::RunKey, std::shared_ptr<const GlyphRun>> CaptionText::m_runCache = {};
+            
+            bool CaptionText::RunKey::operator<( const RunKey& other ) const
+            {
+                if ( m_font != other.m_font )
+                    return m_font < other.m_font;
+                
+                if ( m_size != other.m_size )
+                    return m_size < other.m_size;
+                
+                return m_string < other.m_string;
+            }
+            
+            CaptionText::CaptionText() :
+             m_font( nullptr ),
+             m_charSize( 30 ),
+             m_color( sf::Color::White ),
+             m_changedFrom( CLEAN )
+            {
+            }
+            
+            void CaptionText::setString( const sf::String& string )
+            {
+                if ( string == m_string )
+                    return;
+                
+                // Keep the glyphs of the common prefix
+                std::size_t common = 0;
+                std::size_t length = std::min( string.getSize(), m_string.getSize() );
+                
+                while ( common < length && string[common] == m_string[common] )
+                    ++common;
+                
+                m_string = string;
+                m_changedFrom = std::min( m_changedFrom, common );
+            }
+            
+            void CaptionText::setFont( const sf::Font& font )
+            {
+                if ( m_font == &font )
+                    return;
+                
+                m_font = &font;
+                m_run.reset();
+                m_changedFrom = 0;
+            }
+            
+            void CaptionText::setCharacterSize( const unsigned size )
+            {
+                if ( m_charSize == size )
+                    return;
+                
+                m_charSize = size;
+                m_run.reset();
+                m_changedFrom = 0;
+            }
+            
+            void CaptionText::setFillColor( const sf::Color& color )
+            {
+                m_color = color;
+                
+                for ( auto&& vertex : m_vertices )
+                    vertex.color = color;
+            }
+            
+            const sf::String& CaptionText::getString() const
+            {
+                return m_string;
+            }
+            
+            const sf::Font* CaptionText::getFont() const
+            {
+                return m_font;
+            }
+            
+            unsigned CaptionText::getCharacterSize() const
+            {
+                return m_charSize;
+            }
+            
+            const sf::Color& CaptionText::getFillColor() const
+            {
+                return m_color;
+            }
+            
+            sf::FloatRect CaptionText::getLocalBounds() const
+            {
+                ensureGeometryUpdate();
+                
+                return m_run ? m_run->m_bounds : sf::FloatRect();
+            }
+            
+            sf::FloatRect CaptionText::getGlobalBounds() const
+            {
+                return getTransform().transformRect( getLocalBounds() );
+            }
+            
+            void CaptionText::draw( sf::RenderTarget& target, sf::RenderStates states ) const
+            {
+                if ( !m_font )
+                    return;
+                
+                ensureGeometryUpdate();
+                
+                if ( m_vertices.empty() )
+                    return;
+                
+                states.transform *= getTransform();
+                states.texture = &m_font->getTexture( m_charSize );
+                target.draw( m_vertices.data(), m_vertices.size(), sf::Triangles, states );
+            }
+            
+            void CaptionText::ensureGeometryUpdate() const
+            {
+                if ( m_changedFrom == CLEAN )
+                    return;
+                
+                if ( !m_font )
+                {
+                    m_run.reset();
+                    m_vertices.clear();
+                    m_changedFrom = CLEAN;
+                    return;
+                }
+                
+                // Without a run to reuse, everything is new
+                std::size_t from = m_run ? m_changedFrom : 0;
+                
+                m_run = findRun( *m_font, m_charSize, m_string, m_run.get(), from );
+                
+                // The vertices before the first changed character are still valid
+                std::size_t firstVertex = m_run->m_steps[from].m_vertex;
+                
+                m_vertices.resize( m_run->m_vertices.size() );
+                
+                for ( std::size_t i = firstVertex; i < m_vertices.size(); ++i )
+                {
+                    m_vertices[i] = m_run->m_vertices[i];
+                    m_vertices[i].color = m_color;
+                }
+                
+                m_changedFrom = CLEAN;
+            }
+            
+            std::shared_ptr<const GlyphRun> CaptionText::findRun( const sf::Font& font,
+                                                                  const unsigned size,
+                                                                  const sf::String& string,
+                                                                  const GlyphRun* previous,
+                                                                  std::size_t reuse )
+            {
+                RunKey key{ &font, size, string };
+                
+                auto it = m_runCache.find( key );
+                if ( it != m_runCache.end() )
+                    return it->second;
+                
+                auto run = std::make_shared<GlyphRun>();
+                
+                if ( !previous )
+                    reuse = 0;
+                
+                // Resume from the state before the first new character
+                GlyphRun::Step step;
+                
+                if ( reuse > 0 )
+                {
+                    run->m_steps.assign( previous->m_steps.begin(), previous->m_steps.begin() + reuse + 1 );
+                    step = run->m_steps.back();
+                    run->m_steps.pop_back();
+                    run->m_vertices.assign( previous->m_vertices.begin(), previous->m_vertices.begin() + step.m_vertex );
+                }
+                else
+                {
+                    step.m_vertex = 0;
+                    step.m_pen = sf::Vector2f( 0.f, static_cast<float>( size ) );
+                    step.m_minX = step.m_minY = static_cast<float>( size );
+                    step.m_maxX = step.m_maxY = 0.f;
+                }
+                
+                float whitespace = font.getGlyph( L' ', size, false ).advance;
+                float lineSpacing = font.getLineSpacing( size );
+                
+                // Same layout as sf::Text
+                for ( std::size_t i = reuse; i < string.getSize(); ++i )
+                {
+                    sf::Uint32 current = string[i];
+                    
+                    step.m_vertex = run->m_vertices.size();
+                    run->m_steps.push_back( step );
+                    
+                    if ( i > 0 )
+                        step.m_pen.x += font.getKerning( string[i - 1], current, size );
+                    
+                    if ( current == L' ' || current == L'\t' || current == L'\n' )
+                    {
+                        step.m_minX = std::min( step.m_minX, step.m_pen.x );
+                        step.m_minY = std::min( step.m_minY, step.m_pen.y );
+                        
+                        if ( current == L' ' )
+                            step.m_pen.x += whitespace;
+                        else if ( current == L'\t' )
+                            step.m_pen.x += whitespace * 4;
+                        else
+                        {
+                            step.m_pen.y += lineSpacing;
+                            step.m_pen.x = 0.f;
+                        }
+                        
+                        step.m_maxX = std::max( step.m_maxX, step.m_pen.x );
+                        step.m_maxY = std::max( step.m_maxY, step.m_pen.y );
+                        continue;
+                    }
+                    
+                    const sf::Glyph& glyph = font.getGlyph( current, size, false );
+                    
+                    // Pad the quads by a pixel so that smoothing does not cut them off
+                    const float padding = 1.f;
+                    
+                    float left   = glyph.bounds.left - padding;
+                    float top    = glyph.bounds.top - padding;
+                    float right  = glyph.bounds.left + glyph.bounds.width + padding;
+                    float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+                    
+                    float u1 = static_cast<float>( glyph.textureRect.left ) - padding;
+                    float v1 = static_cast<float>( glyph.textureRect.top ) - padding;
+                    float u2 = static_cast<float>( glyph.textureRect.left + glyph.textureRect.width ) + padding;
+                    float v2 = static_cast<float>( glyph.textureRect.top + glyph.textureRect.height ) + padding;
+                    
+                    sf::Vector2f pen = step.m_pen;
+                    
+                    run->m_vertices.push_back( sf::Vertex( pen + sf::Vector2f( left, top ), sf::Color::White, sf::Vector2f( u1, v1 ) ) );
+                    run->m_vertices.push_back( sf::Vertex( pen + sf::Vector2f( right, top ), sf::Color::White, sf::Vector2f( u2, v1 ) ) );
+                    run->m_vertices.push_back( sf::Vertex( pen + sf::Vector2f( left, bottom ), sf::Color::White, sf::Vector2f( u1, v2 ) ) );
+                    run->m_vertices.push_back( sf::Vertex( pen + sf::Vector2f( left, bottom ), sf::Color::White, sf::Vector2f( u1, v2 ) ) );
+                    run->m_vertices.push_back( sf::Vertex( pen + sf::Vector2f( right, top ), sf::Color::White, sf::Vector2f( u2, v1 ) ) );
+                    run->m_vertices.push_back( sf::Vertex( pen + sf::Vector2f( right, bottom ), sf::Color::White, sf::Vector2f( u2, v2 ) ) );
+                    
+                    step.m_minX = std::min( step.m_minX, pen.x + glyph.bounds.left );
+                    step.m_maxX = std::max( step.m_maxX, pen.x + glyph.bounds.left + glyph.bounds.width );
+                    step.m_minY = std::min( step.m_minY, pen.y + glyph.bounds.top );
+                    step.m_maxY = std::max( step.m_maxY, pen.y + glyph.bounds.top + glyph.bounds.height );
+                    
+                    step.m_pen.x += glyph.advance;
+                }
+                
+                step.m_vertex = run->m_vertices.size();
+                run->m_steps.push_back( step );
+                
+                run->m_bounds = sf::FloatRect( step.m_minX, step.m_minY, step.m_maxX - step.m_minX, step.m_maxY - step.m_minY );
+                
+                // The captions keep their own runs alive, dropping the
+                // cache only costs the next lookups a layout
+                if ( m_runCache.size() >= UI_CAPTION_RUN_CACHE_SIZE )
+                    m_runCache.clear();
+                
+                m_runCache.emplace( std::move( key ), run );
+                
+                return run;
+            }
+            
+            ///////////////////////////////////////////////////////////////////////////////////////////
+            
             C_UICaption::C_UICaption( const std::string& text,
                                       const FontID fontID,
                                       const int charSize,
@@ -0,0 +1,164 @@
+/*
+ * -------------------------
+ *  Module    : Utility
+ *  Submodule : ThreadPool
+ * -------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 01-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  Contains implementation of the methods & classes declared
+ *  in ThreadPool submodule.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "Utility/ThreadPool.hpp"
+
+namespace rts
+{
+    ThreadPool& ThreadPool::getInstance()
+    {
+        // hardware_concurrency() may not know the number of cores & return 0
+        static ThreadPool pool( std::max( std::thread::hardware_concurrency(), 1u ) - 1 );
+        return pool;
+    }
+    
+    ThreadPool::ThreadPool( const unsigned workers ) :
+     m_stopping( false )
+    {
+        for ( unsigned i = 0; i < workers; ++i )
+            m_workers.emplace_back( &ThreadPool::work, this );
+    }
+    
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_stopping = true;
+        }
+        
+        m_wake.notify_all();
+        
+        for ( auto&& worker : m_workers )
+            worker.join();
+    }
+    
+    unsigned ThreadPool::getWorkerCount() const
+    {
+        return static_cast<unsigned>( m_workers.size() );
+    }
+    
+    void ThreadPool::submit( std::function<void()> task )
+    {
+        if ( m_workers.empty() )
+        {
+            task();
+            return;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_tasks.push_back( std::move( task ) );
+        }
+        
+        m_wake.notify_one();
+    }
+    
+    void ThreadPool::parallelFor( const std::size_t count,
+                                  const std::size_t grain,
+                                  const std::function<void( std::size_t begin, std::size_t end )>& job )
+    {
+        std::size_t chunkSize = std::max<std::size_t>( grain, 1 );
+        std::size_t chunks = ( count + chunkSize - 1 ) / chunkSize;
+        
+        // Not worth waking anyone up for
+        if ( chunks <= 1 || m_workers.empty() )
+        {
+            if ( count > 0 )
+                job( 0, count );
+            
+            return;
+        }
+        
+        // Every thread taking part grabs the next chunk until there are none
+        // left. A helper may only start once the loop is over, e.g., when the
+        // workers are busy decoding assets, so the state it touches is shared
+        // & the job is only run for a chunk the caller still waits for.
+        struct Loop
+        {
+            std::atomic<std::size_t> m_nextChunk;
+            std::size_t m_doneChunks;
+            std::mutex m_mutex;
+            std::condition_variable m_done;
+        };
+        
+        auto loop = std::make_shared<Loop>();
+        loop->m_nextChunk = 0;
+        loop->m_doneChunks = 0;
+        
+        const auto* jobPtr = &job;
+        
+        auto runChunks = [loop, jobPtr, chunks, chunkSize, count]()
+        {
+            std::size_t done = 0;
+            
+            for ( std::size_t c = loop->m_nextChunk++; c < chunks; c = loop->m_nextChunk++ )
+            {
+                ( *jobPtr )( c * chunkSize, std::min( ( c + 1 ) * chunkSize, count ) );
+                ++done;
+            }
+            
+            if ( done == 0 )
+                return;
+            
+            std::lock_guard<std::mutex> lock( loop->m_mutex );
+            loop->m_doneChunks += done;
+            
+            if ( loop->m_doneChunks == chunks )
+                loop->m_done.notify_one();
+        };
+        
+        std::size_t helpers = std::min<std::size_t>( m_workers.size(), chunks - 1 );
+        
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            
+            for ( std::size_t i = 0; i < helpers; ++i )
+                m_tasks.push_back( runChunks );
+        }
+        
+        m_wake.notify_all();
+        
+        runChunks();
+        
+        std::unique_lock<std::mutex> lock( loop->m_mutex );
+        loop->m_done.wait( lock, [&]() { return loop->m_doneChunks == chunks; } );
+    }
+    
+    void ThreadPool::work()
+    {
+        while ( true )
+        {
+            std::function<void()> task;
+            
+            {
+                std::unique_lock<std::mutex> lock( m_mutex );
+                m_wake.wait( lock, [this]() { return m_stopping || !m_tasks.empty(); } );
+                
+                if ( m_stopping )
+                    return;
+                
+                task = std::move( m_tasks.front() );
+                m_tasks.pop_front();
+            }
+            
+            task();
+        }
+    }
+}
@@ -15,8 +15,6 @@
  * 
  */
 
-#include <climits>
-
 #include "Utility/Constants.hpp"
 #include "Utility/Log.hpp"
 #include "ResourceManager/ResourceManager.hpp"
@@ -28,68 +26,43 @@ namespace rts
     {
         namespace EntityComponents
         {
-            AnimationComponent::AnimationComponent() :
-             m_textureRect{ INT_MIN, INT_MIN, INT_MIN, INT_MIN },
-             m_frameSize{ INT_MIN, INT_MIN },
-             m_currentFrame{ -1 },
-             m_maxFrame{ INT_MAX },
-             m_duration{ sf::Time::Zero },
-             m_elapsedTime{ sf::Time::Zero },
-             m_loop{ true },
-             m_visible{ true }
+            AnimationComponent::AnimationComponent()
             {
                 m_type = SpriteType::NONE;
                 m_entitySprite.m_spritePtr = nullptr;
-                m_entitySprite.m_vertexArrayPtr = nullptr;
             }
             
-            AnimationComponent::AnimationComponent( sf::Sprite* entitySprite,
-                                                    const sf::Vector2i frameSize,
-                                                    const unsigned maxFrame,
-                                                    const sf::Time duration ) :
-             m_frameSize{ frameSize },
-             m_currentFrame{ 0 },
-             m_maxFrame{ static_cast<int>( maxFrame ) },
-             m_duration{ duration },
-             m_elapsedTime{ sf::Time::Zero },
-             m_loop{ true },
-             m_visible{ true }
+            AnimationComponent::AnimationComponent( sf::Sprite* entitySprite )
             {
                 m_type = SpriteType::SF_SPRITE;
                 m_entitySprite.m_spritePtr = entitySprite;
-                m_textureRect = sf::IntRect{ 0, 0, m_frameSize.x, m_frameSize.y };
-                m_entitySprite.m_spritePtr->setTextureRect( m_textureRect );
             }
             
-            AnimationComponent::AnimationComponent( sf::VertexArray* vertexArray,
-                                                    const sf::Vector2i frameSize,
-                                                    const unsigned maxFrame,
-                                                    const sf::Time duration ) :
-             m_frameSize{ frameSize },
-             m_currentFrame{ 0 },
-             m_maxFrame{ static_cast<int>( maxFrame ) },
-             m_duration{ duration },
-             m_elapsedTime{ sf::Time::Zero },
-             m_loop{ true },
-             m_visible{ true }
+            AnimationComponent::AnimationComponent( sf::VertexArray* vertexArray )
             {
                 m_type = SpriteType::SF_VERTEX_ARRAY;
                 m_entitySprite.m_vertexArrayPtr = vertexArray;
-                //m_textureRect = sf::IntRect{ m_frameSize.x / 2, m_frameSize.x, m_frameSize.x, m_frameSize.y };
-                
-                (*m_entitySprite.m_vertexArrayPtr)[0].texCoords.x = m_frameSize.x / 2;
-                (*m_entitySprite.m_vertexArrayPtr)[0].texCoords.y = 0;
-                
-                (*m_entitySprite.m_vertexArrayPtr)[1].texCoords.x = m_frameSize.x;
-                (*m_entitySprite.m_vertexArrayPtr)[1].texCoords.y = m_frameSize.y / 2;
-                
-                (*m_entitySprite.m_vertexArrayPtr)[2].texCoords.x = m_frameSize.x / 2;
-                (*m_entitySprite.m_vertexArrayPtr)[2].texCoords.y = m_frameSize.y;
-                
-                (*m_entitySprite.m_vertexArrayPtr)[3].texCoords.x = 0;
-                (*m_entitySprite.m_vertexArrayPtr)[3].texCoords.y = m_frameSize.y / 2;
-                
-                //m_entitySprite.m_spritePtr->setTextureRect( m_textureRect );
+            }
+            
+            void AnimationComponent::setFrame( const sf::IntRect& frame )
+            {
+                if ( m_type == SpriteType::SF_SPRITE )
+                {
+                    m_entitySprite.m_spritePtr->setTextureRect( frame );
+                }
+                else if ( m_type == SpriteType::SF_VERTEX_ARRAY )
+                {
+                    // The vertex array holds a diamond inscribed in the frame
+                    float left   = static_cast<float>( frame.left );
+                    float top    = static_cast<float>( frame.top );
+                    float width  = static_cast<float>( frame.width );
+                    float height = static_cast<float>( frame.height );
+                    
+                    (*m_entitySprite.m_vertexArrayPtr)[0].texCoords = sf::Vector2f{ left + width / 2.f, top };
+                    (*m_entitySprite.m_vertexArrayPtr)[1].texCoords = sf::Vector2f{ left + width, top + height / 2.f };
+                    (*m_entitySprite.m_vertexArrayPtr)[2].texCoords = sf::Vector2f{ left + width / 2.f, top + height };
+                    (*m_entitySprite.m_vertexArrayPtr)[3].texCoords = sf::Vector2f{ left, top + height / 2.f };
+                }
             }
         }
     }
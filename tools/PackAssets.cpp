@@ -0,0 +1,151 @@
+/*
+ * ------------------------
+ *  Module    : Tools
+ *  Submodule : PackAssets
+ * ------------------------
+ *  Author : Koushtav Chakrabarty < theillusionistmirage@gmail.com >
+ *  Date   : 01-01-2018
+ * 
+ *  This file is a part of the software that resides here:
+ *  https://github.com/TheIllusionistMirage/rts-feat
+ * ------------------------------------------------------------------
+ * 
+ *  Packs asset files into one archive, see ResourceManager/AssetArchive.hpp
+ *  for the format. Run as a build step:
+ * 
+ *      rtspak <archive> <file>...
+ * 
+ *  Each file is stored under the path it is given by, which must be the
+ *  path the game loads it by, e.g., assets/textures/mouse-pointer.png.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "ResourceManager/AssetArchive.hpp"
+
+namespace
+{
+    struct PackedFile
+    {
+        std::string m_path;
+        rts::AssetArchiveEntry m_entry;
+        std::vector<char> m_bytes;
+    };
+    
+    rts::AssetFormat formatOf( const std::string& path )
+    {
+        std::string extension = path.substr( path.find_last_of( '.' ) + 1 );
+        std::transform( extension.begin(), extension.end(), extension.begin(), ::tolower );
+        
+        if ( extension == "png" )
+            return rts::AssetFormat::PNG;
+        
+        if ( extension == "jpg" || extension == "jpeg" )
+            return rts::AssetFormat::JPG;
+        
+        if ( extension == "ttf" || extension == "otf" )
+            return rts::AssetFormat::FONT;
+        
+        return rts::AssetFormat::OTHER;
+    }
+}
+
+int main( int argc, char** argv )
+{
+    if ( argc < 3 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <archive> <file>..." << std::endl;
+        return 1;
+    }
+    
+    std::vector<PackedFile> files;
+    
+    for ( int i = 2; i < argc; ++i )
+    {
+        PackedFile file;
+        file.m_path = argv[i];
+        
+        std::ifstream stream( file.m_path, std::ios::binary );
+        if ( !stream.is_open() )
+        {
+            std::cerr << "Unable to open " << file.m_path << std::endl;
+            return 1;
+        }
+        
+        file.m_bytes.assign( std::istreambuf_iterator<char>( stream ), std::istreambuf_iterator<char>() );
+        
+        std::memset( &file.m_entry, 0, sizeof( file.m_entry ) );
+        file.m_entry.m_id = rts::AssetArchive::hashPath( file.m_path );
+        file.m_entry.m_size = file.m_bytes.size();
+        file.m_entry.m_format = formatOf( file.m_path );
+        
+        files.push_back( std::move( file ) );
+    }
+    
+    // The reader looks the entries up by binary search
+    std::sort( files.begin(), files.end(), []( const PackedFile& a, const PackedFile& b )
+    {
+        return a.m_entry.m_id < b.m_entry.m_id;
+    } );
+    
+    for ( std::size_t i = 1; i < files.size(); ++i )
+    {
+        if ( files[i - 1].m_entry.m_id == files[i].m_entry.m_id )
+        {
+            std::cerr << "Duplicate ID for " << files[i - 1].m_path << " and " << files[i].m_path << std::endl;
+            return 1;
+        }
+    }
+    
+    // Lay the files out after the header & entries, each aligned to 16 bytes
+    std::uint64_t offset = sizeof( rts::AssetArchiveHeader ) + files.size() * sizeof( rts::AssetArchiveEntry );
+    
+    for ( auto&& file : files )
+    {
+        offset = ( offset + 15 ) & ~std::uint64_t( 15 );
+        file.m_entry.m_offset = offset;
+        offset += file.m_entry.m_size;
+    }
+    
+    rts::AssetArchiveHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.m_magic, rts::ASSET_ARCHIVE_MAGIC, sizeof( header.m_magic ) );
+    header.m_version = rts::ASSET_ARCHIVE_VERSION;
+    header.m_entryCount = static_cast<std::uint32_t>( files.size() );
+    
+    std::ofstream archive( argv[1], std::ios::binary | std::ios::trunc );
+    if ( !archive.is_open() )
+    {
+        std::cerr << "Unable to create " << argv[1] << std::endl;
+        return 1;
+    }
+    
+    archive.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    
+    for ( auto&& file : files )
+        archive.write( reinterpret_cast<const char*>( &file.m_entry ), sizeof( file.m_entry ) );
+    
+    for ( auto&& file : files )
+    {
+        // Pad up to the offset of the file
+        std::vector<char> padding( static_cast<std::size_t>( file.m_entry.m_offset - archive.tellp() ), 0 );
+        archive.write( padding.data(), padding.size() );
+        archive.write( file.m_bytes.data(), file.m_bytes.size() );
+    }
+    
+    if ( !archive.good() )
+    {
+        std::cerr << "Unable to write " << argv[1] << std::endl;
+        return 1;
+    }
+    
+    std::cout << "Packed " << files.size() << " files into " << argv[1] << " (" << offset << " bytes)" << std::endl;
+    
+    return 0;
+}